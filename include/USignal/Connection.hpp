@@ -1,9 +1,12 @@
 #pragma once
 
+#include "details/SignalAnchor.h"
 #include "details/Util.h"
 
 #include <type_traits>
 #include <algorithm>
+#include <functional>
+#include <span>
 
 namespace Ubpa {
 	template<typename Func>
@@ -19,6 +22,17 @@ namespace Ubpa {
 	constexpr bool operator<(const Connection& lhs, const Connection& rhs);
 	constexpr bool operator==(const Connection& lhs, const Connection& rhs);
 
+	namespace details {
+		struct ConnectionHash {
+			std::size_t operator()(const Connection& connection) const noexcept {
+				std::size_t hash = std::hash<const void*>{}(connection.instance);
+				for (std::size_t word : connection.funcptr.data)
+					hash ^= std::hash<std::size_t>{}(word) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+		};
+	}
+
 	// You need to ensure that the life of the signal is longer than the life of the scpoed connection
 	// The signal is movable, so you need to change the signal pointer of the scpoed connection when moving the signal
 	template<typename Func>
@@ -36,6 +50,10 @@ namespace Ubpa {
 
 		void MoveInstance(void* instance);
 
+		// if the instance lies in [srcBegin, srcEnd), rebase it to dstBegin
+		// it only updates this connection, use it after Signal::RelocateRange
+		void Relocate(const void* srcBegin, const void* srcEnd, void* dstBegin) noexcept;
+
 		void Release();
 
 		void Reset() noexcept;
@@ -45,6 +63,43 @@ namespace Ubpa {
 	};
 	template<typename Func>
 	ScopedConnection(const Connection&, Signal<Func>*)->ScopedConnection<Func>;
+
+	// a scoped connection which is safe to outlive or move the signal
+	// the signal and its tracked connections share a pooled control block (one per signal)
+	// - a moved signal (e.g. a MSignal member of an element in std::vector) stays reachable
+	// - if the signal is destroyed, the destructor and Release do nothing
+	template<typename Func>
+	struct TrackedConnection : Connection {
+		TrackedConnection() noexcept;
+		TrackedConnection(const Connection& conn, details::SignalAnchor* anchor) noexcept;
+		TrackedConnection(TrackedConnection&& other) noexcept;
+		~TrackedConnection();
+
+		TrackedConnection& operator=(TrackedConnection&& rhs) noexcept;
+
+		void Swap(TrackedConnection& other) noexcept;
+
+		// nullptr if the signal is destroyed or the connection is empty
+		Signal<Func>* GetSignal() const noexcept;
+
+		void MoveInstance(void* instance);
+
+		// disconnect now
+		void Release();
+
+		// keep the slot connected and forget it
+		void Reset() noexcept;
+
+		TrackedConnection(const TrackedConnection&) = delete;
+		TrackedConnection& operator=(const TrackedConnection&) = delete;
+
+	private:
+		details::SignalAnchor* anchor;
+	};
+
+	// the bulk version of ScopedConnection::Relocate
+	template<typename Func>
+	void RelocateRange(std::span<ScopedConnection<Func>> connections, const void* srcBegin, const void* srcEnd, void* dstBegin) noexcept;
 }
 
 #include "details/Connection.inl"
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Connection.hpp"
+
+#include <chrono>
+#include <optional>
+#include <tuple>
+
+namespace Ubpa {
+	template<typename Func>
+	class EmissionCursor;
+
+	// a resumable emission, see Signal::EmitIncremental
+	// the cursor keeps a copy of the arguments until the emission is done,
+	// and tracks the signal like TrackedConnection (the emission ends if the signal is destroyed)
+	template<typename... Args>
+	class EmissionCursor<void(Args...)> {
+	public:
+		EmissionCursor() noexcept = default;
+		EmissionCursor(EmissionCursor&&) noexcept = default;
+		EmissionCursor& operator=(EmissionCursor&&) noexcept = default;
+
+		// call the next slots until budget is spent (at least one slot is called)
+		// return true if the emission is done
+		bool Resume(std::chrono::nanoseconds budget);
+
+		bool Done() const noexcept { return !args.has_value(); }
+
+		// the number of called slots
+		std::size_t NumCalled() const noexcept { return numCalled; }
+
+		// end the emission and release the arguments
+		void Cancel() noexcept;
+
+		EmissionCursor(const EmissionCursor&) = delete;
+		EmissionCursor& operator=(const EmissionCursor&) = delete;
+
+	private:
+		friend class Signal<void(Args...)>;
+
+		EmissionCursor(details::SignalAnchor* anchor, std::type_identity_t<Args>... args);
+
+		details::SignalAnchorRef anchor;
+		std::optional<std::tuple<std::remove_cvref_t<Args>...>> args;
+		std::optional<Connection> last; // the last called slot
+		std::size_t numCalled{ 0 };
+	};
+}
+
+#include "details/EmissionCursor.inl"
@@ -0,0 +1,168 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "USignal/EmissionLog.hpp is only supported on Linux"
+#endif
+
+#include "Signal.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace Ubpa {
+	// customization point of the emission log
+	// specialize it for the argument types which are not trivially copyable
+	// - static std::size_t Size(const T& value)
+	// - static std::byte* Write(std::byte* dst, const T& value), return the end of the written bytes
+	// - static T Read(const std::byte*& src), advance src
+	// - static bool Skip(const std::byte*& src, const std::byte* end), optional, advance src over a value,
+	//   return false if it doesn't fit in [src, end), the replayer drops such a record without reading it
+	template<typename T>
+	struct EmissionSerializer {
+		static_assert(std::is_trivially_copyable_v<T>, "specialize EmissionSerializer for the non-trivially-copyable type");
+
+		static constexpr std::size_t Size(const T&) noexcept { return sizeof(T); }
+
+		static std::byte* Write(std::byte* dst, const T& value) noexcept {
+			std::memcpy(dst, &value, sizeof(T));
+			return dst + sizeof(T);
+		}
+
+		static T Read(const std::byte*& src) noexcept {
+			std::array<std::byte, sizeof(T)> bytes;
+			std::memcpy(bytes.data(), src, sizeof(T));
+			src += sizeof(T);
+			return std::bit_cast<T>(bytes);
+		}
+
+		static bool Skip(const std::byte*& src, const std::byte* end) noexcept {
+			if (static_cast<std::size_t>(end - src) < sizeof(T))
+				return false;
+			src += sizeof(T);
+			return true;
+		}
+	};
+
+	template<>
+	struct EmissionSerializer<std::string> {
+		static std::size_t Size(const std::string& value) noexcept { return sizeof(std::uint64_t) + value.size(); }
+		static std::byte* Write(std::byte* dst, const std::string& value) noexcept;
+		static std::string Read(const std::byte*& src);
+		static bool Skip(const std::byte*& src, const std::byte* end) noexcept;
+	};
+
+	// record emissions into a memory-mapped append-only log file
+	// every thread appends records into its own buffer, the full buffer is copied into the log as a chunk
+	// records are dropped when the log is full, the log never grows
+	class EmissionRecorder {
+	public:
+		// capacity: the maximum size of the log file in bytes, it is mapped at once
+		// bufferSize: the size of the per-thread buffer in bytes
+		EmissionRecorder(const char* path, std::size_t capacity, std::size_t bufferSize = 64 * 1024);
+		~EmissionRecorder();
+
+		EmissionRecorder(const EmissionRecorder&) = delete;
+		EmissionRecorder& operator=(const EmissionRecorder&) = delete;
+
+		bool IsOpen() const noexcept { return log != nullptr; }
+
+		template<typename... Ts>
+		void Record(std::uint32_t signalID, const Ts&... args);
+
+		// record the emission, then emit the signal
+		template<typename Ret, typename... Args>
+		void Emit(std::uint32_t signalID, Signal<Ret(Args...)>& signal, std::type_identity_t<Args>... args);
+
+		// write all per-thread buffers into the log
+		// recording threads must be idle
+		void Flush();
+
+		// flush, shrink the file to the used size and unmap it
+		// recording threads must be idle
+		void Close();
+
+		std::size_t NumDropped() const noexcept { return numDropped.load(std::memory_order_relaxed); }
+
+	private:
+		struct ThreadBuffer {
+			std::thread::id owner;
+			std::size_t numRecords{ 0 };
+			std::vector<std::byte> data;
+		};
+
+		ThreadBuffer& GetThreadBuffer();
+		void FlushBuffer(ThreadBuffer& buffer);
+
+		static std::uint64_t NextID() noexcept {
+			static std::atomic<std::uint64_t> next{ 1 };
+			return next.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const std::uint64_t id{ NextID() };
+		int fd{ -1 };
+		std::byte* log{ nullptr };
+		std::size_t capacity;
+		std::size_t bufferSize;
+		std::atomic<std::uint64_t> validEnd;
+		std::atomic<std::size_t> numDropped{ 0 };
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	};
+
+	// drive signals with the records of an emission log
+	// a truncated or corrupted log is read up to the first malformed chunk
+	class EmissionReplayer {
+	public:
+		explicit EmissionReplayer(const char* path);
+		~EmissionReplayer();
+
+		EmissionReplayer(const EmissionReplayer&) = delete;
+		EmissionReplayer& operator=(const EmissionReplayer&) = delete;
+
+		bool IsOpen() const noexcept { return log != nullptr; }
+
+		// the records of signalID are emitted by signal
+		// the argument types must be the same as the recorded ones
+		template<typename Ret, typename... Args>
+		void Bind(std::uint32_t signalID, Signal<Ret(Args...)>& signal);
+
+		std::size_t NumRecords() const noexcept { return records.size(); }
+
+		// true if a chunk, a record or its arguments don't fit in the log, the records before it are kept
+		bool IsMalformed() const noexcept { return malformed; }
+
+		// emit the records in timestamp order
+		// speed: 1 is the recorded speed, 2 is twice as fast, 0 means no waiting
+		// return the number of emitted records
+		// records without a bound signal are skipped, so are records whose arguments don't fit in their payload
+		std::size_t Replay(double speed = 1.);
+
+	private:
+		struct Record {
+			std::uint64_t timestamp;
+			std::uint32_t signalID;
+			std::uint32_t payloadSize;
+			const std::byte* payload;
+		};
+
+		const std::byte* log{ nullptr };
+		std::size_t size{ 0 };
+		bool malformed{ false };
+		std::vector<Record> records;
+		// return false if the payload is malformed
+		small_flat_map<std::uint32_t, unique_function<bool(const std::byte*, const std::byte*)>> handlers;
+	};
+}
+
+#include "details/EmissionLog.inl"
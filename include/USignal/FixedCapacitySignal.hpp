@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Signal.hpp"
+#include "details/InplaceFunction.h"
+
+#include <array>
+
+namespace Ubpa {
+	template<typename Func, std::size_t N, std::size_t InlineBytes = 2 * sizeof(void*)>
+	class FixedCapacitySignal;
+
+	// a signal which never allocates, it is suitable for real-time threads
+	// - at most N slots, Connect returns std::nullopt when it is full
+	// - every slot is stored in an inline buffer of InlineBytes, larger callable objects are rejected at compile time
+	// the slot rules are the same as Signal
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	class FixedCapacitySignal<Ret(Args...), N, InlineBytes> {
+		using FuncSig = Ret(void*, Args...);
+
+	public:
+		FixedCapacitySignal() noexcept = default;
+		FixedCapacitySignal(const FixedCapacitySignal&) = delete;
+		FixedCapacitySignal& operator=(const FixedCapacitySignal&) = delete;
+		FixedCapacitySignal(FixedCapacitySignal&& other) noexcept;
+		FixedCapacitySignal& operator=(FixedCapacitySignal&& rhs) noexcept;
+		~FixedCapacitySignal() { Clear(); }
+
+		//
+		// Connect
+		////////////
+		// return std::nullopt if the signal is full or the connection exists
+
+		// you can only use the result to disconnect with this
+		template<typename Slot>
+		std::optional<Connection> Connect(Slot&& slot);
+
+		template<auto funcptr>
+		std::optional<Connection> Connect();
+
+		// memslot
+		// - member function pointer
+		// - function pointer, the first argument is treated as the object, it can be a pointer or reference
+		// if T is const, the object type in memslot must also be const
+		template<auto memslot, typename T>
+		std::optional<Connection> Connect(T* obj);
+
+		// memslot
+		// 1. member function pointer
+		// 2. function pointer, the first argument is treated as the object, it can be a pointer or reference
+		// 3. callable object
+		// in case 1 and 2, we use memslot as the funcptr of the result connection
+		// if T is const, the object type in memslot must also be const
+		template<typename MemSlot, typename T>
+		std::optional<Connection> Connect(MemSlot&& memslot, T* obj);
+
+		//
+		// Disconnect
+		///////////////
+
+		void Disconnect(const Connection& connection) noexcept;
+
+		template<typename T>
+		void Disconnect(const T* ptr) noexcept;
+
+		template<auto memslot>
+		void Disconnect(const details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>* obj) noexcept;
+
+		//
+		// Emit
+		/////////
+
+		void Emit(Args... args);
+
+		template<typename Acc> requires std::negation_v<std::is_void<Ret>>
+		void Emit(Acc&& acc, Args... args);
+
+		//
+		// Modify
+		///////////
+
+		template<typename T>
+		void MoveInstance(T* dst, const T* src) noexcept;
+
+		void Clear() noexcept;
+
+		//
+		// Query
+		//////////
+
+		std::size_t Size() const noexcept { return size; }
+		static constexpr std::size_t Capacity() noexcept { return N; }
+		bool Full() const noexcept { return size == N; }
+
+	private:
+		struct Entry {
+			Connection connection;
+			details::InplaceFunction<FuncSig, InlineBytes> slot;
+		};
+
+		// sorted by connection in [0, size)
+		Entry* Begin() noexcept { return entries.data(); }
+		Entry* End() noexcept { return entries.data() + size; }
+		Entry* LowerBound(const Connection& connection) noexcept;
+		Entry* LowerBound(const void* instance) noexcept;
+
+		template<typename Slot>
+		std::optional<Connection> ConnectImpl(const Connection& connection, Slot&& slot);
+		void Erase(Entry* first, Entry* last) noexcept;
+
+		std::size_t innerID{ 0 };
+		std::size_t size{ 0 };
+		bool isEmitting{ false };
+		std::array<Entry, N> entries;
+	};
+}
+
+#include "details/FixedCapacitySignal.inl"
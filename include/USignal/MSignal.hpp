@@ -13,8 +13,17 @@ namespace Ubpa {
 	public:
 		using Signal<Ret(Args...)>::Connect;
 		using Signal<Ret(Args...)>::ScopeConnect;
+		using Signal<Ret(Args...)>::ScopeConnectTracked;
+		using Signal<Ret(Args...)>::ConnectBatch;
+		using Signal<Ret(Args...)>::ScopeConnectBatch;
 		using Signal<Ret(Args...)>::Disconnect;
 		using Signal<Ret(Args...)>::MoveInstance;
+		using Signal<Ret(Args...)>::RelocateRange;
+		using Signal<Ret(Args...)>::CloneInstance;
+		using Signal<Ret(Args...)>::Size;
+		using Signal<Ret(Args...)>::Empty;
+		using Signal<Ret(Args...)>::MemoryUsage;
+		using Signal<Ret(Args...)>::StopEmit;
 	protected:
 		friend T;
 		MSignal() = default;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Signal.hpp"
+
+#include <tuple>
+
+namespace Ubpa::details {
+	template<typename Func>
+	struct MultiSlot;
+
+	template<typename... Args>
+	struct MultiSlot<void(Args...)> {
+		using Invoker = void(*)(void*, Args...);
+
+		template<auto memslot>
+		static constexpr Invoker Get() noexcept {
+			if constexpr (std::is_null_pointer_v<decltype(memslot)>)
+				return nullptr;
+			else {
+				return [](void* obj, Args... args) {
+					SlotExpand<void(Args...)>::template mem_get<memslot>()(obj, std::forward<Args>(args)...);
+				};
+			}
+		}
+
+		// the arguments are converted to Args once (at the call), as in Signal::Emit,
+		// then passed to every receiver, they are only moved for rvalue reference parameters
+		template<std::size_t I, typename Receivers>
+		static void Emit(const Receivers& receivers, Args... args) {
+			for (const auto& [obj, table] : receivers) {
+				// the receivers which don't implement the signature cost a null check
+				if (const auto invoker = std::get<I>(*table))
+					invoker(obj, PassSlotArg<Args>(args)...);
+			}
+		}
+	};
+
+	// the class of a member slot, see MemSlotInstance
+	template<typename MemSlot, bool IsMemFunc = std::is_member_function_pointer_v<MemSlot>>
+	struct MemSlotObject { using type = member_pointer_traits_object<MemSlot>; };
+	template<typename MemSlot>
+	struct MemSlotObject<MemSlot, false> {
+		using type = std::remove_cv_t<std::remove_reference_t<std::remove_pointer_t<Front_t<FuncTraits_ArgList<MemSlot>>>>>;
+	};
+
+	// obj adjusted to the class of memslot, nullptr if memslot is nullptr
+	template<auto memslot, typename T>
+	void* MultiSlotInstance(T* obj) noexcept {
+		if constexpr (std::is_null_pointer_v<decltype(memslot)>)
+			return nullptr;
+		else {
+			static_assert(std::is_base_of_v<typename MemSlotObject<decltype(memslot)>::type, std::remove_const_t<T>>,
+				"the memslots of MultiSignal::Connect must be members of T or of its bases");
+			return MemSlotInstance<decltype(memslot)>(obj);
+		}
+	}
+}
+
+namespace Ubpa {
+	// sibling signals of one owner (e.g. OnAdd(Item), OnRemove(Item), OnClear()) sharing one table of receivers
+	// a receiver is one entry {instance, invoker table}, the table holds an invoker per signature
+	// and is shared by all receivers connected with the same member slots
+	// - Emit<I> calls the I-th invoker of every receiver which implements it
+	// - Disconnect(obj) removes the receiver from all signatures with one erase
+	// only member slots (as in Signal::Connect<memslot>(obj)) can be connected, use Signal for other callable objects
+	template<typename... Funcs>
+	class MultiSignal {
+		static_assert((std::is_void_v<FuncTraits_Return<Funcs>> && ...), "the signatures of MultiSignal must return void");
+
+	public:
+		using Table = std::tuple<typename details::MultiSlot<Funcs>::Invoker...>;
+
+		// one memslot per signature (in order), nullptr if obj doesn't receive the signature
+		// e.g. Connect<&T::OnAdd, &T::OnRemove, nullptr>(obj)
+		// the memslots must belong to T or its bases, and agree on one adjusted instance (e.g. all members of the same base)
+		// the receiver is keyed by the adjusted instance, as in Signal::Connect<memslot>(obj),
+		// so Disconnect, MoveInstance and Contains take a pointer to the class of the memslots
+		// reconnecting obj replaces its memslots, return true if obj is a new receiver
+		template<auto... memslots, typename T>
+		bool Connect(T* obj);
+
+		void Disconnect(const void* obj);
+
+		// the receiver at src is moved to dst
+		template<typename T>
+		void MoveInstance(T* dst, const T* src);
+
+		template<std::size_t I, typename... Ts>
+		void Emit(Ts&&... args);
+
+		// the number of receivers
+		std::size_t Size() const noexcept { return receivers.size(); }
+
+		bool Empty() const noexcept { return receivers.empty(); }
+
+		bool Contains(const void* obj) const { return receivers.find(obj) != receivers.end(); }
+
+		std::size_t MemoryUsage() const noexcept;
+
+		void Clear() noexcept { receivers.clear(); }
+
+	private:
+		template<auto... memslots>
+		static constexpr Table table{ details::MultiSlot<Funcs>::template Get<memslots>()... };
+
+		bool isEmitting{ false };
+		small_flat_map<void*, const Table*, 16, std::less<>> receivers;
+	};
+}
+
+#include "details/MultiSignal.inl"
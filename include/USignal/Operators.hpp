@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Signal.hpp"
+
+#include <tuple>
+
+namespace Ubpa::details {
+	template<typename Pred>
+	struct FilterOp { Pred pred; };
+
+	template<typename Fn>
+	struct MapOp { Fn fn; };
+
+	template<typename Sink>
+	struct IntoOp { Sink sink; };
+
+	template<typename Func, typename... Stages>
+	class SignalPipe;
+
+	// a pending chain of operators on a source signal
+	// it is connected to the source signal as one slot by `| Into(...)`
+	template<typename... Args, typename... Stages>
+	class [[nodiscard]] SignalPipe<void(Args...), Stages...> {
+	public:
+		SignalPipe(Signal<void(Args...)>& source, std::tuple<Stages...> stages) :
+			source{ source }, stages{ std::move(stages) } {}
+
+		template<typename Stage>
+		SignalPipe<void(Args...), Stages..., Stage> Append(Stage&& stage) &&;
+
+		template<typename Sink>
+		Connection Connect(Sink&& sink) &&;
+
+	private:
+		Signal<void(Args...)>& source;
+		std::tuple<Stages...> stages;
+	};
+}
+
+namespace Ubpa {
+	// signal operators
+	// - source | Filter(pred) | Map(fn) | ... | Into(slot)
+	// all operators are fused into a single slot of the source signal,
+	// there is no intermediate signal or emission
+	// require
+	// - the source signal returns void
+	// - Filter: pred(values...) -> bool, values are passed as lvalues
+	// - Map: fn(values...) -> value, the result is the only value of the following operators
+	// - Into: slot(values...), the result of slot is ignored
+
+	template<typename Pred>
+	[[nodiscard]] details::FilterOp<std::decay_t<Pred>> Filter(Pred&& pred) { return { std::forward<Pred>(pred) }; }
+
+	template<typename Fn>
+	[[nodiscard]] details::MapOp<std::decay_t<Fn>> Map(Fn&& fn) { return { std::forward<Fn>(fn) }; }
+
+	// the slot is a callable object
+	template<typename Slot>
+	[[nodiscard]] details::IntoOp<std::decay_t<Slot>> Into(Slot&& slot) { return { std::forward<Slot>(slot) }; }
+
+	// emit the target signal, the target signal must outlive the connection
+	template<typename Ret, typename... Args>
+	[[nodiscard]] auto Into(Signal<Ret(Args...)>& target);
+
+	template<typename... Args, typename Pred>
+	auto operator|(Signal<void(Args...)>& source, details::FilterOp<Pred> op);
+
+	template<typename... Args, typename Fn>
+	auto operator|(Signal<void(Args...)>& source, details::MapOp<Fn> op);
+
+	template<typename... Args, typename Sink>
+	Connection operator|(Signal<void(Args...)>& source, details::IntoOp<Sink> op);
+
+	template<typename Func, typename... Stages, typename Pred>
+	auto operator|(details::SignalPipe<Func, Stages...>&& pipe, details::FilterOp<Pred> op);
+
+	template<typename Func, typename... Stages, typename Fn>
+	auto operator|(details::SignalPipe<Func, Stages...>&& pipe, details::MapOp<Fn> op);
+
+	template<typename Func, typename... Stages, typename Sink>
+	Connection operator|(details::SignalPipe<Func, Stages...>&& pipe, details::IntoOp<Sink> op);
+}
+
+#include "details/Operators.inl"
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "MSignal.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Ubpa {
+	template<typename T>
+	class Property;
+
+	template<typename T>
+	class Computed;
+
+	class PropertyBatch;
+}
+
+namespace Ubpa::details {
+	template<typename Owner, typename T>
+	class ReactiveSignal;
+}
+
+namespace Ubpa::details {
+	// a node of the dependency graph of properties and computed values
+	// the graph is updated by push-pull
+	// - push: Property::Set marks the direct observers Dirty and the other descendants Check (maybe dirty)
+	// - pull: a read updates the sources of a Check/Dirty node first, then recomputes the node only if a source changed
+	// so a read never sees a mix of old and new values (no glitches), and every node recomputes at most once per change
+	class ReactiveNode {
+	public:
+		ReactiveNode(const ReactiveNode&) = delete;
+		ReactiveNode& operator=(const ReactiveNode&) = delete;
+
+	protected:
+		template<typename T>
+		friend class Ubpa::Property;
+		template<typename T>
+		friend class Ubpa::Computed;
+		friend class Ubpa::PropertyBatch;
+		template<typename Owner, typename T>
+		friend class ReactiveSignal;
+
+		enum class State : std::uint8_t { Clean, Check, Dirty };
+
+		ReactiveNode(std::uint32_t rank, State state) noexcept : rank{ rank }, state{ state } {}
+		// a node must outlive its observers
+		virtual ~ReactiveNode();
+
+		// make the node Clean
+		virtual void UpdateIfNecessary() = 0;
+		// emit the changed signal if the value changed since the last flush
+		virtual void Notify() = 0;
+		// a node with connected slots is updated at the end of the batch, the other nodes are updated when they are read
+		virtual bool IsObserved() const noexcept = 0;
+
+		void Mark(State newState);
+		void Enqueue();
+		// update and notify the enqueued nodes in topological order, unless a batch is open
+		static void FlushIfIdle();
+
+		std::vector<ReactiveNode*> observers;
+		std::uint32_t rank; // 0 for a property, 1 + the max rank of the sources for a computed value
+		State state;
+		bool enqueued{ false };
+	};
+
+	// the changed signal of a node
+	// the first connection updates the node, so the later changes of the sources reach it
+	// every member of MSignal which adds slots is wrapped
+	template<typename Owner, typename T>
+	class ReactiveSignal : public MSignal<Owner, void(const T&)> {
+		using Base = MSignal<Owner, void(const T&)>;
+
+	public:
+		template<typename... Ts>
+		Connection Connect(Ts&&... ts) {
+			Subscribe();
+			return Base::Connect(std::forward<Ts>(ts)...);
+		}
+
+		template<auto slot, typename... Ts>
+		Connection Connect(Ts&&... ts) {
+			Subscribe();
+			return Base::template Connect<slot>(std::forward<Ts>(ts)...);
+		}
+
+		template<typename... Ts>
+		ScopedConnection<void(const T&)> ScopeConnect(Ts&&... ts)
+		{ return { Connect(std::forward<Ts>(ts)...), this }; }
+
+		template<auto slot, typename... Ts>
+		ScopedConnection<void(const T&)> ScopeConnect(Ts&&... ts)
+		{ return { Connect<slot>(std::forward<Ts>(ts)...), this }; }
+
+		template<typename... Ts>
+		TrackedConnection<void(const T&)> ScopeConnectTracked(Ts&&... ts) {
+			Subscribe();
+			return Base::ScopeConnectTracked(std::forward<Ts>(ts)...);
+		}
+
+		template<auto slot, typename... Ts>
+		TrackedConnection<void(const T&)> ScopeConnectTracked(Ts&&... ts) {
+			Subscribe();
+			return Base::template ScopeConnectTracked<slot>(std::forward<Ts>(ts)...);
+		}
+
+		template<auto batchfunc, typename U>
+		Connection ConnectBatch(U* obj) {
+			Subscribe();
+			return Base::template ConnectBatch<batchfunc>(obj);
+		}
+
+		template<auto batchfunc, typename U>
+		ScopedConnection<void(const T&)> ScopeConnectBatch(U* obj) {
+			Subscribe();
+			return Base::template ScopeConnectBatch<batchfunc>(obj);
+		}
+
+		std::size_t CloneInstance(const void* src, void* dst) {
+			Subscribe();
+			return Base::CloneInstance(src, dst);
+		}
+
+	private:
+		friend Owner;
+		explicit ReactiveSignal(ReactiveNode* owner) noexcept : owner{ owner } {}
+
+		void Subscribe() {
+			if (Base::Empty())
+				owner->UpdateIfNecessary();
+		}
+
+		ReactiveNode* owner;
+	};
+
+	struct ReactiveContext {
+		std::vector<ReactiveNode*> queue;
+		std::size_t batchDepth{ 0 };
+		bool flushing{ false };
+
+		static ReactiveContext& Instance() {
+			thread_local ReactiveContext context;
+			return context;
+		}
+	};
+}
+
+namespace Ubpa {
+	// a value with a changed signal, it is the source of computed values
+	// Set does nothing if the new value equals the current value
+	// not movable (the computed values refer to it), not thread-safe
+	template<typename T>
+	class Property : public details::ReactiveNode {
+	public:
+		Property() : ReactiveNode{ 0, State::Clean }, changed{ this } {}
+		explicit Property(T value) : ReactiveNode{ 0, State::Clean }, changed{ this }, value{ std::move(value) } {}
+
+		const T& Get() const noexcept { return value; }
+
+		void Set(T newValue);
+
+		// emitted with the new value, once per batch
+		details::ReactiveSignal<Property, T> changed;
+
+	private:
+		void UpdateIfNecessary() override {}
+		void Notify() override { changed.Emit(value); }
+		bool IsObserved() const noexcept override { return !changed.Empty(); }
+
+		T value{};
+	};
+
+	// a value derived from properties and other computed values, func(sources.Get()...) -> T
+	// - lazy: it is recomputed when it is read after a source changed, or at the end of the batch if it has connected slots
+	// - it is recomputed at most once per batch, and only if the value of a source changed
+	// - if the new value equals the old one, the changed signal is not emitted and the observers are not recomputed
+	// not movable, not thread-safe
+	template<typename T>
+	class Computed : public details::ReactiveNode {
+	public:
+		template<typename Func, typename... Sources>
+		explicit Computed(Func&& func, Sources&... sources);
+		~Computed();
+
+		const T& Get();
+
+		// emitted with the new value, once per batch
+		details::ReactiveSignal<Computed, T> changed;
+
+	private:
+		void UpdateIfNecessary() override;
+		void Notify() override;
+		bool IsObserved() const noexcept override { return !changed.Empty(); }
+
+		unique_function<T()> compute;
+		std::vector<details::ReactiveNode*> sources;
+		std::optional<T> value;
+		bool changedSinceNotify{ false };
+	};
+
+	template<typename Func, typename... Sources>
+	Computed(Func&&, Sources&...) -> Computed<std::decay_t<std::invoke_result_t<Func, decltype(std::declval<Sources&>().Get())...>>>;
+
+	// defer the updates and the changed signals until the outermost batch ends,
+	// so setting several properties recomputes every observed value once
+	class PropertyBatch {
+	public:
+		PropertyBatch() noexcept { details::ReactiveContext::Instance().batchDepth++; }
+		~PropertyBatch();
+
+		PropertyBatch(const PropertyBatch&) = delete;
+		PropertyBatch& operator=(const PropertyBatch&) = delete;
+	};
+}
+
+#include "details/Property.inl"
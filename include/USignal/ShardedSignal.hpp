@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Signal.hpp"
+#include "details/SpinMutex.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace Ubpa {
+	template<typename Func, std::size_t N = 16>
+	class ShardedSignal;
+
+	// a signal for high connect/disconnect churn from many threads
+	// connections are distributed to N independent slot tables (shards) by Connection::instance,
+	// and every shard has its own lock, so writers of different shards don't block each other
+	// the connections of an instance-less slot are distributed by Connection::funcptr
+	// all member functions are thread-safe
+	// slots can't connect/disconnect this signal during the emission
+	template<typename Ret, typename... Args, std::size_t N>
+	class ShardedSignal<Ret(Args...), N> {
+		static_assert(N > 0);
+		using FuncSig = Ret(void*, Args...);
+
+	public:
+		ShardedSignal() = default;
+		ShardedSignal(const ShardedSignal&) = delete;
+		ShardedSignal& operator=(const ShardedSignal&) = delete;
+
+		//
+		// Connect
+		////////////
+
+		// you can only use the result to disconnect with this
+		template<typename Slot>
+		Connection Connect(Slot&& slot);
+
+		template<auto funcptr>
+		Connection Connect();
+
+		// memslot
+		// - member function pointer
+		// - function pointer, the first argument is treated as the object, it can be a pointer or reference
+		// if T is const, the object type in memslot must also be const
+		template<auto memslot, typename T>
+		Connection Connect(T* obj);
+
+		// memslot
+		// 1. member function pointer
+		// 2. function pointer, the first argument is treated as the object, it can be a pointer or reference
+		// 3. callable object
+		// in case 1 and 2, we use memslot as the funcptr of the result connection
+		// if T is const, the object type in memslot must also be const
+		template<typename MemSlot, typename T>
+		Connection Connect(MemSlot&& memslot, T* obj);
+
+		//
+		// Disconnect
+		///////////////
+
+		void Disconnect(const Connection& connection);
+
+		template<typename T>
+		void Disconnect(const T* ptr);
+
+		template<auto memslot>
+		void Disconnect(const details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>* obj);
+
+		//
+		// Emit
+		/////////
+		// shards are emitted one by one, every shard is locked during its emission
+
+		void Emit(Args... args);
+
+		template<typename Acc> requires std::negation_v<std::is_void<Ret>>
+		void Emit(Acc&& acc, Args... args);
+
+		//
+		// Modify
+		///////////
+
+		void Clear() noexcept;
+
+		//
+		// Query
+		//////////
+
+		// it is a snapshot when other threads are connecting/disconnecting
+		std::size_t Size() const noexcept;
+
+		static constexpr std::size_t NumShards() noexcept { return N; }
+
+	private:
+		struct alignas(64) Shard {
+			mutable details::SpinMutex mutex;
+			Signal<Ret(Args...)> signal;
+		};
+
+		static std::size_t ShardIndex(const Connection& connection) noexcept;
+		static std::size_t ShardIndex(const void* instance) noexcept;
+
+		template<typename Slot>
+		Connection ConnectImpl(const Connection& connection, Slot&& slot);
+
+		std::atomic<std::size_t> innerID{ 0 };
+		std::array<Shard, N> shards;
+	};
+}
+
+#include "details/ShardedSignal.inl"
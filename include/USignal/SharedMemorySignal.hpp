@@ -0,0 +1,116 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "USignal/SharedMemorySignal.hpp is only supported on Linux"
+#endif
+
+#include "Signal.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace Ubpa {
+	enum class SharedMemoryRole {
+		Publisher, // create the shared memory and emit into it
+		Subscriber // open the shared memory and call local slots
+	};
+
+	template<typename Func>
+	class SharedMemorySignal;
+
+	// a signal across processes on one machine
+	// the publisher writes the arguments into a ring buffer in POSIX shared memory (lock-free, multiple emitting threads),
+	// every subscriber reads the ring buffer and emits its local signal
+	// - subscribers never block the publisher, a subscriber that falls behind by more than capacity drops the oldest emissions
+	// - an emitting thread only waits if another thread of the publisher is still writing the entry one lap (capacity emissions) before
+	// - idle subscribers sleep on a futex in the shared memory, the publisher only calls futex wake if some subscriber sleeps
+	// - a subscriber receives the emissions after it is opened
+	// Args must be trivially copyable
+	template<typename... Args>
+	class SharedMemorySignal<void(Args...)> {
+	public:
+		// name: the POSIX shared memory object, e.g. "/my_signal"
+		// capacity: the number of emissions in the ring buffer, rounded up to a power of two (only used by the publisher)
+		// the publisher unlinks the shared memory object in the destructor
+		// a publisher fails to open (IsOpen() is false) if the shared memory object already exists
+		SharedMemorySignal(const char* name, SharedMemoryRole role, std::size_t capacity = 4096);
+		~SharedMemorySignal();
+
+		SharedMemorySignal(const SharedMemorySignal&) = delete;
+		SharedMemorySignal& operator=(const SharedMemorySignal&) = delete;
+
+		bool IsOpen() const noexcept { return header != nullptr; }
+
+		//
+		// Publisher
+		//////////////
+
+		void Emit(std::type_identity_t<Args>... args);
+
+		//
+		// Subscriber
+		///////////////
+		// the local slots are called in the reader thread (or in Poll)
+		// slots can't connect or disconnect this signal
+
+		template<typename... Ts>
+		Connection Connect(Ts&&... ts);
+
+		template<auto slot, typename... Ts>
+		Connection Connect(Ts&&... ts);
+
+		void Disconnect(const Connection& connection);
+
+		template<typename T>
+		void Disconnect(const T* ptr);
+
+		// emit the local signal with the new emissions in the calling thread
+		// don't call it while the reader thread runs
+		// return the number of handled emissions
+		std::size_t Poll();
+
+		// start a reader thread which polls and sleeps when there is nothing to read
+		void Start();
+
+		// stop and join the reader thread
+		void Stop();
+
+		// the number of emissions this subscriber lost because it fell behind
+		std::uint64_t NumDropped() const noexcept { return numDropped.load(std::memory_order_relaxed); }
+
+	private:
+		static_assert((std::is_trivially_copyable_v<std::remove_cvref_t<Args>> && ...),
+			"the arguments of SharedMemorySignal must be trivially copyable");
+
+		static constexpr std::size_t PayloadSize = (std::size_t{ 0 } + ... + sizeof(std::remove_cvref_t<Args>));
+
+		struct Header;
+		struct Entry;
+
+		Entry& GetEntry(std::uint64_t position) noexcept;
+		void Dispatch(const std::byte* payload);
+		void ReaderLoop();
+
+		int fd{ -1 };
+		SharedMemoryRole role;
+		std::string name;
+		Header* header{ nullptr };
+		std::size_t mappedSize{ 0 };
+
+		// subscriber
+		std::uint64_t readPosition{ 0 };
+		std::atomic<std::uint64_t> numDropped{ 0 };
+		std::mutex mutex; // guards signal
+		Signal<void(Args...)> signal;
+		std::atomic<bool> running{ false };
+		std::thread reader;
+	};
+}
+
+#include "details/SharedMemorySignal.inl"
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Signal.hpp"
+
+#include <memory>
+
+namespace Ubpa {
+	template<typename Func>
+	class SharedSlot;
+
+	// a refcounted callable object stored once and connected to many signals
+	// every signal only keeps a reference to the callable, so the state of the callable is shared
+	// require
+	// - the signal signature must be compatible with Ret(Args...) (see Signal)
+	// the connected signals are tracked like TrackedConnection, so they can be moved
+	// Destroying/clearing a connected signal is safe, its connections are removed from the shared slot
+	template<typename Ret, typename... Args>
+	class SharedSlot<Ret(Args...)> {
+	public:
+		SharedSlot() noexcept = default;
+
+		template<typename Slot>
+		explicit SharedSlot(Slot&& slot);
+
+		// copies share the callable and the connections
+		SharedSlot(const SharedSlot&) noexcept = default;
+		SharedSlot(SharedSlot&&) noexcept = default;
+		SharedSlot& operator=(const SharedSlot&) noexcept = default;
+		SharedSlot& operator=(SharedSlot&&) noexcept = default;
+
+		template<typename SignalFunc>
+		Connection ConnectTo(Signal<SignalFunc>& signal);
+
+		// disconnect the callable from all connected signals
+		void DisconnectAll();
+
+		std::size_t NumConnections() const noexcept { return block ? block->entries.size() : 0; }
+
+		explicit operator bool() const noexcept { return static_cast<bool>(block); }
+
+	private:
+		struct Entry {
+			std::size_t id;
+			details::SignalAnchorRef anchor; // follows the signal when it is moved
+			Connection connection;
+			void(*disconnect)(details::SignalAnchorHandle* signal, const Connection& connection);
+		};
+
+		struct Block {
+			unique_function<Ret(Args...)> func;
+			std::size_t nextID{ 0 };
+			small_vector<Entry> entries;
+		};
+
+		// stored in every connected signal
+		// it unregisters itself from the block when the signal drops the slot
+		class Binding {
+		public:
+			Binding(std::shared_ptr<Block> block, std::size_t id) noexcept : block{ std::move(block) }, id{ id } {}
+			Binding(Binding&& other) noexcept = default;
+			Binding& operator=(Binding&&) = delete;
+			~Binding();
+
+			Ret operator()(Args... args) const;
+
+		private:
+			std::shared_ptr<Block> block;
+			std::size_t id;
+		};
+
+		std::shared_ptr<Block> block;
+	};
+}
+
+#include "details/SharedSlot.inl"
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Connection.hpp"
+#include "EmissionCursor.hpp"
+#include "details/SpinMutex.h"
 
 #include <UFunction.hpp>
 
@@ -8,13 +10,29 @@
 
 #include <UTemplate/Func.hpp>
 
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_set>
 #include <variant>
+#include <vector>
 
 namespace Ubpa {
 	template<typename Func>
 	class Signal;
 
+	template<typename Func, std::size_t N>
+	class ShardedSignal;
+
+	template<typename... Funcs>
+	class SignalGroup;
+
+	template<typename Func, std::size_t K>
+	class StickySignal;
+
 	// you can register function R(Ts...)
 	// require
 	// - if Ret is void, R can be any type, else R should be implicit convertible to Ret
@@ -22,7 +40,7 @@ namespace Ubpa {
 	// for example
 	// float(const int&) is compatible with void(int)
 	template<typename Ret, typename... Args>
-	class Signal<Ret(Args...)> {
+	class Signal<Ret(Args...)> : public details::SignalAnchorHandle {
 		using FuncSig = Ret(void*, Args...);
 
 	public:
@@ -30,7 +48,7 @@ namespace Ubpa {
 		Signal(const Signal&) = delete;
 		Signal& operator=(const Signal&) = delete;
 		Signal(Signal&&) noexcept = default;
-		Signal& operator=(Signal&&) noexcept = default;
+		Signal& operator=(Signal&& rhs) noexcept;
 
 		//
 		// Connect
@@ -62,6 +80,14 @@ namespace Ubpa {
 		template<typename MemSlot, typename T>
 		Connection Connect(MemSlot&& memslot, T* obj);
 
+		// batchfunc: void(std::span<T*>, ...), e.g. static void T::OnTickBatch(std::span<T*>, Args...)
+		// the objects connected to the same batchfunc are stored in one sorted array,
+		// and batchfunc is called once per emission with all of them (at the position of an instance-less slot)
+		// the result connection is { obj, batchfunc }, Disconnect/MoveInstance/RelocateRange work as usual
+		// Disconnect<batchfunc>() disconnects all the objects of the batch
+		template<auto batchfunc, typename T> requires std::is_void_v<Ret>
+		Connection ConnectBatch(T* obj);
+
 		//
 		// Scope Connect
 		//////////////////
@@ -94,6 +120,20 @@ namespace Ubpa {
 		template<typename MemSlot, typename T>
 		ScopedConnection<Ret(Args...)> ScopeConnect(MemSlot&& memslot, T* obj);
 
+		template<auto batchfunc, typename T> requires std::is_void_v<Ret>
+		ScopedConnection<Ret(Args...)> ScopeConnectBatch(T* obj);
+
+		//
+		// Tracked Connect
+		////////////////////
+		// the same arguments as Connect, the result stays valid when the signal is moved or destroyed
+
+		template<typename... Ts>
+		TrackedConnection<Ret(Args...)> ScopeConnectTracked(Ts&&... ts);
+
+		template<auto slot, typename... Ts>
+		TrackedConnection<Ret(Args...)> ScopeConnectTracked(Ts&&... ts);
+
 		//
 		// Disconnect
 		///////////////
@@ -128,6 +168,85 @@ namespace Ubpa {
 		template<typename Acc> requires std::negation_v<std::is_void<Ret>>
 		void Emit(Acc&& acc, Args... args);
 
+		// write the results into out in slot order, return the number of written results
+		// if out is smaller than Size(), the remaining slots are not called
+		template<typename R = Ret> requires std::negation_v<std::is_void<R>>
+		std::size_t EmitCollect(std::span<std::type_identity_t<R>> out, Args... args);
+
+		// clear out and fill it in slot order, the capacity of out is reused
+		// return the number of written results
+		template<typename R = Ret> requires std::negation_v<std::is_void<R>>
+		std::size_t EmitCollect(std::vector<std::type_identity_t<R>>& out, Args... args);
+
+		// call slots in order until pred(result) returns true or a slot calls StopEmit()
+		// return the connection of the slot that consumed the emission
+		template<typename Pred> requires std::negation_v<std::is_void<Ret>>
+		std::optional<Connection> EmitUntil(Pred&& pred, Args... args);
+
+		// call slots in order until a slot calls StopEmit()
+		// return the connection of the slot that consumed the emission
+		template<typename R = Ret> requires std::is_void_v<R>
+		std::optional<Connection> EmitUntil(Args... args);
+
+		// factory() returns the arguments, a std::tuple of them or (for a single parameter) the argument itself
+		// factory is called once at the first slot, so nothing is built if no slot runs
+		// return true if any slot is called
+		template<typename Factory>
+		bool EmitLazy(Factory&& factory);
+
+		// only the slots whose connection passes filter(const Connection&) are called
+		// factory is called once at the first passed slot
+		template<typename Filter, typename Factory>
+		bool EmitLazy(Filter&& filter, Factory&& factory);
+
+		// call slots in order until budget is spent (at least one slot), return a cursor to continue with the next slots
+		// the cursor copies the arguments, the signal can be changed between the resumptions
+		// - a connected slot is called if it comes after the last called slot in the order of connections
+		// - a disconnected slot is not called
+		// - a moved signal is followed, a destroyed signal ends the emission
+		// a slot calling StopEmit() ends the emission
+		// a batch (see ConnectBatch) is one slot, so all its instances are called in one step regardless of the budget
+		// Args can't be non-const lvalue references, the slots would change the copy in the cursor
+		template<typename R = Ret> requires std::is_void_v<R>
+		EmissionCursor<Ret(Args...)> EmitIncremental(std::chrono::nanoseconds budget, Args... args);
+
+		// called in a slot during EmitUntil (or EmitIncremental), the remaining slots are skipped
+		// it has no effect on Emit and EmitCollect
+		void StopEmit() noexcept {
+			assert(isEmitting);
+			isStopped = true;
+		}
+
+		//
+		// Clone
+		//////////
+		// the slots connected by Connect<memslot>(obj) and Connect<funcptr>() (or the ScopeConnect versions) are copyable,
+		// other slots are skipped
+
+		// a signal with copies of the copyable slots, the instance of every connection is remapped by map(void*) -> void*
+		// the connections mapped to nullptr are dropped, instance-less slots are copied as is
+		template<typename Map>
+		Signal Clone(Map&& map) const;
+
+		// connect copies of the copyable slots of src to dst, return the number of new connections
+		std::size_t CloneInstance(const void* src, void* dst);
+
+		//
+		// Query
+		//////////
+
+		// number of slots, you can use it to pre-size the buffer of EmitCollect
+		std::size_t Size() const noexcept;
+
+		// O(1), you can use it to skip building expensive arguments
+		bool Empty() const noexcept { return slots.empty() && pending.empty(); }
+
+		// the bytes used by the signal
+		// - the signal itself (including the inline slots)
+		// - the heap capacity of the slot table (Connection and unique_function entries)
+		// - the callable objects which are too large to be stored in unique_function (estimated)
+		std::size_t MemoryUsage() const noexcept;
+
 		//
 		// Modify
 		///////////
@@ -135,19 +254,97 @@ namespace Ubpa {
 		template<typename T>
 		void MoveInstance(T* dst, const T* src);
 
+		// rebase all connections whose instance lies in [srcBegin, srcEnd) to dstBegin in one pass
+		// the ranges are arrays of objects of stride bytes, an instance keeps its offset from the range begin
+		// (e.g. a base subobject of an element)
+		// use it when an object array is reallocated or compacted, instead of MoveInstance per object
+		void RelocateRange(const void* srcBegin, const void* srcEnd, void* dstBegin, std::size_t stride);
+
+		template<typename T>
+		void RelocateRange(const T* srcBegin, const T* srcEnd, T* dstBegin)
+		{ RelocateRange(static_cast<const void*>(srcBegin), static_cast<const void*>(srcEnd), static_cast<void*>(dstBegin), sizeof(T)); }
+
 		void Clear() noexcept;
 
 		void Swap(Signal& other) noexcept {
+			SwapAnchor(other);
 			std::swap(innerID, other.innerID);
 			std::swap(slots, other.slots);
+			std::swap(pending, other.pending);
+			std::swap(pendingKeys, other.pendingKeys);
+			std::swap(batches, other.batches);
 		}
 
+		// in lazy connect mode, Connect appends the slot without sorting (it only looks up the sorted table and a hash set)
+		// Emit doesn't sort, the appended slots are called after the sorted ones
+		// the appended slots are sorted and merged in place into the table at the first Disconnect or MoveInstance
+		// a connection connected twice keeps its first slot as in eager mode
+		// disabling the mode sorts the appended slots at once
+		void SetLazyConnect(bool enable);
+
 	private:
+		template<typename Func, std::size_t N>
+		friend class ShardedSignal;
+
+		template<typename... Funcs>
+		friend class SignalGroup;
+
+		template<typename Func, std::size_t K>
+		friend class StickySignal;
+
+		template<typename Func>
+		friend class EmissionCursor;
+
+		template<typename Func>
+		friend class SharedSlot;
+
 		size_t innerID{ 0 };
 		template<typename Slot>
 		void ConnectImpl(const Connection& connection, Slot&& slot);
+		// slot must be constructible to unique_function<FuncSig>, a boxed slot is counted by the anchor
+		template<typename Slot>
+		unique_function<FuncSig> WrapSlot(Slot&& slot);
+		// the factory of a copyable slot, registered at the first connection
+		using SlotFactory = unique_function<FuncSig>(*)(Signal&);
+		template<auto slot, bool member>
+		static unique_function<FuncSig> MakeSlot(Signal& target);
+		template<auto slot, bool member>
+		static void RegisterSlotFactory();
+		// append copies of the copyable slots in [first, last) to buffer
+		template<typename Iter, typename Map>
+		void CloneSlots(Iter first, Iter last, Map&& map, Signal& target,
+			std::vector<std::pair<Connection, unique_function<FuncSig>>>& buffer) const;
+		void InsertSlot(const Connection& connection, unique_function<FuncSig>&& func);
+		// visitor(connection, slot) returns true to stop
+		template<typename Visitor>
+		void Visit(Visitor&& visitor);
+		void MergePending();
+		// merge a sorted run of unique connections into the table in place, return the number of new connections
+		std::size_t MergeSorted(std::vector<std::pair<Connection, unique_function<FuncSig>>>& run);
+		// call the slot of connection only, return false if there is no such slot
+		template<typename... Ts>
+		bool InvokeSlot(const Connection& connection, Ts&&... args);
+		// call the slots after cursor.last until deadline, return true if the emission is done
+		bool ResumeEmission(EmissionCursor<Ret(Args...)>& cursor, std::chrono::steady_clock::time_point deadline);
+		// the sorted instances of a batchfunc
+		using Batch = std::pair<details::FuncPtr, std::unique_ptr<std::vector<void*>>>;
+		std::vector<void*>* FindBatch(const details::FuncPtr& batchfunc) noexcept;
+		typename std::vector<Batch>::iterator FindBatchIter(const details::FuncPtr& batchfunc) noexcept;
+		// return false if connection is not a batch connection
+		// an empty batch is removed with its slot
+		bool DisconnectBatch(const Connection& connection);
 		bool isEmitting{ false };
-		small_flat_map<Connection, unique_function<FuncSig>, 16, std::less<>> slots;
+		bool isStopped{ false };
+		bool lazyConnect{ false };
+		// the number of slots stored in the signal itself
+		static constexpr std::size_t InlineSlots = 16;
+		small_flat_map<Connection, unique_function<FuncSig>, InlineSlots, std::less<>> slots;
+		// unsorted slots appended in lazy connect mode
+		std::vector<std::pair<Connection, unique_function<FuncSig>>> pending;
+		// the connections in pending, to drop a duplicated connection in O(1)
+		std::unordered_set<Connection, details::ConnectionHash> pendingKeys;
+		// sorted instances of every batchfunc, the slot { nullptr, batchfunc } calls batchfunc with them
+		std::vector<Batch> batches;
 	};
 }
 
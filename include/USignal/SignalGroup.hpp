@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Signal.hpp"
+
+#include <tuple>
+
+namespace Ubpa::details {
+	template<typename... Funcs>
+	struct CombinedSignature;
+	template<>
+	struct CombinedSignature<> { using type = void(); };
+	template<typename Ret, typename... Args, typename... Funcs>
+	struct CombinedSignature<Ret(Args...), Funcs...> {
+		template<typename Func>
+		struct Prepend;
+		template<typename... Others>
+		struct Prepend<void(Others...)> { using type = void(Args..., Others...); };
+		using type = typename Prepend<typename CombinedSignature<Funcs...>::type>::type;
+	};
+
+	template<typename Func>
+	struct SignalArgList;
+	template<typename Ret, typename... Args>
+	struct SignalArgList<Ret(Args...)> { using type = TypeList<Args...>; };
+}
+
+namespace Ubpa {
+	// several related signals emitted together
+	// in Emit, slots are grouped by receiver instance:
+	// the slots of one instance in all signals (and its combined slots) are called in a row,
+	// so every receiver object is touched once per emission
+	// - Get<I>() is the I-th signal, it can also be emitted alone
+	// - Combined() is a signal of the concatenated arguments of all signals,
+	//   its slots are only called by SignalGroup::Emit
+	template<typename... Funcs>
+	class SignalGroup {
+	public:
+		using CombinedFunc = typename details::CombinedSignature<Funcs...>::type;
+
+		template<std::size_t I>
+		auto& Get() noexcept { return std::get<I>(signals); }
+
+		template<std::size_t I>
+		const auto& Get() const noexcept { return std::get<I>(signals); }
+
+		Signal<CombinedFunc>& Combined() noexcept { return combined; }
+		const Signal<CombinedFunc>& Combined() const noexcept { return combined; }
+
+		// args is the argument tuple of every signal,
+		// e.g. group.Emit(std::forward_as_tuple(pos), std::forward_as_tuple(rot), std::forward_as_tuple(bounds))
+		// the arguments are converted to the parameter types of the signals at every slot call
+		template<typename... ArgTuples>
+		void Emit(ArgTuples&&... args);
+
+	private:
+		std::tuple<Signal<Funcs>...> signals;
+		Signal<CombinedFunc> combined;
+	};
+}
+
+#include "details/SignalGroup.inl"
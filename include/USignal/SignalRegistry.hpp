@@ -0,0 +1,85 @@
+#pragma once
+
+#include "MSignal.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Ubpa {
+	class SignalRegistry;
+
+	struct SignalStats {
+		std::string name;
+		const void* signal;
+		std::size_t numSlots;
+		std::size_t memoryUsage; // Signal::MemoryUsage
+	};
+
+	// unregister the signal when it is destroyed
+	// You need to ensure that the life of the signal is longer than the life of the registration
+	// The signal is movable, so you need to register the moved signal again
+	class SignalRegistration {
+	public:
+		SignalRegistration() noexcept = default;
+		SignalRegistration(SignalRegistration&& other) noexcept;
+		SignalRegistration& operator=(SignalRegistration&& rhs) noexcept;
+		~SignalRegistration() { Release(); }
+
+		void Release();
+
+		SignalRegistration(const SignalRegistration&) = delete;
+		SignalRegistration& operator=(const SignalRegistration&) = delete;
+
+	private:
+		friend class SignalRegistry;
+		SignalRegistration(SignalRegistry* registry, const void* signal) noexcept :
+			registry{ registry }, signal{ signal } {}
+
+		SignalRegistry* registry{ nullptr };
+		const void* signal{ nullptr };
+	};
+
+	// an opt-in registry of live signals for memory introspection
+	// registration doesn't change the signal, so it costs nothing on the Emit path
+	// it is thread-safe, but Snapshot reads the registered signals,
+	// so they must not be modified by other threads during Snapshot
+	class SignalRegistry {
+	public:
+		static SignalRegistry& Instance() {
+			static SignalRegistry instance;
+			return instance;
+		}
+
+		template<typename Func>
+		[[nodiscard]] SignalRegistration Register(const Signal<Func>* signal, std::string name);
+
+		// the Signal base of MSignal is protected, so it is registered as itself
+		template<typename T, typename Func>
+		[[nodiscard]] SignalRegistration Register(const MSignal<T, Func>* signal, std::string name);
+
+		void Unregister(const void* signal);
+
+		std::size_t NumSignals() const;
+
+		// sorted by memory usage in descending order
+		std::vector<SignalStats> Snapshot() const;
+
+	private:
+		// SignalType provides Size and MemoryUsage
+		template<typename SignalType>
+		SignalRegistration RegisterImpl(const SignalType* signal, std::string name);
+
+		struct Entry {
+			const void* signal;
+			std::string name;
+			std::size_t(*size)(const void* signal) noexcept;
+			std::size_t(*memoryUsage)(const void* signal) noexcept;
+		};
+
+		mutable std::mutex mutex;
+		std::vector<Entry> entries;
+	};
+}
+
+#include "details/SignalRegistry.inl"
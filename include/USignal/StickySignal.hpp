@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Signal.hpp"
+
+#include <array>
+#include <optional>
+#include <tuple>
+
+namespace Ubpa {
+	template<typename Func, std::size_t K = 1>
+	class StickySignal;
+
+	// a signal of a state, it caches the arguments of the last K emissions
+	// a new slot can be called with the cached arguments at connect time (ConnectReplay),
+	// so subscribers don't query (and the owner doesn't recompute) the current state
+	// Args must be copyable values or const references, the slots can't modify the cache
+	template<typename... Args, std::size_t K>
+	class StickySignal<void(Args...), K> : protected Signal<void(Args...)> {
+		static_assert(K > 0);
+		static_assert(((!std::is_reference_v<Args> || std::is_const_v<std::remove_reference_t<Args>>) && ...),
+			"the arguments of StickySignal must be values or const references");
+
+	public:
+		using Values = std::tuple<std::remove_cvref_t<Args>...>;
+
+		using Signal<void(Args...)>::Connect;
+		using Signal<void(Args...)>::ScopeConnect;
+		using Signal<void(Args...)>::ScopeConnectTracked;
+		using Signal<void(Args...)>::Disconnect;
+		using Signal<void(Args...)>::MoveInstance;
+		using Signal<void(Args...)>::Size;
+		using Signal<void(Args...)>::Empty;
+		using Signal<void(Args...)>::SetLazyConnect;
+
+		StickySignal() = default;
+		StickySignal(StickySignal&&) noexcept = default;
+		StickySignal& operator=(StickySignal&&) noexcept = default;
+
+		// connect like Connect, then call the new slot with the cached emissions (oldest first)
+		template<typename... Ts>
+		Connection ConnectReplay(Ts&&... ts);
+
+		template<auto slot, typename... Ts>
+		Connection ConnectReplay(Ts&&... ts);
+
+		template<typename... Ts>
+		ScopedConnection<void(Args...)> ScopeConnectReplay(Ts&&... ts);
+
+		template<auto slot, typename... Ts>
+		ScopedConnection<void(Args...)> ScopeConnectReplay(Ts&&... ts);
+
+		// cache the arguments, then call all slots with the cached copy
+		void Emit(std::type_identity_t<Args>... args);
+
+		// cache the arguments without calling the slots
+		void Set(std::type_identity_t<Args>... args);
+
+		// the arguments of the last emission, nullptr if there is none
+		const Values* Latest() const noexcept;
+
+		// the number of cached emissions, at most K
+		std::size_t NumCached() const noexcept { return numCached; }
+
+		// the i-th cached emission, 0 is the oldest
+		const Values& Cached(std::size_t i) const noexcept;
+
+		// drop the cached emissions
+		void ResetCache() noexcept;
+
+	private:
+		Values& Push(std::type_identity_t<Args>... args);
+		void Replay(const Connection& connection);
+
+		std::array<std::optional<Values>, K> cache;
+		std::size_t next{ 0 }; // the index of the next emission in cache
+		std::size_t numCached{ 0 };
+	};
+}
+
+#include "details/StickySignal.inl"
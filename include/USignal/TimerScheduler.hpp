@@ -0,0 +1,114 @@
+#pragma once
+
+#include <UFunction.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Ubpa {
+	// the handle of a scheduled task, generation 0 is empty
+	struct TimerHandle {
+		std::uint32_t index{ 0 };
+		std::uint32_t generation{ 0 };
+
+		explicit operator bool() const noexcept { return generation != 0; }
+	};
+
+	// a scheduler of delayed and periodic tasks, backed by a hierarchical timing wheel
+	// (4 levels of 64 slots, a task is cascaded to a lower level when its upper slot comes due)
+	// - schedule and cancel are O(1), the entries are pooled in slabs and linked by index
+	// - the time is read from an injectable clock in Update, or set by AdvanceTo
+	// - a delay is rounded up to ticks and measured from the last update, the tasks run in Update/AdvanceTo
+	// not thread-safe
+	template<typename Clock = std::chrono::steady_clock>
+	class TimerScheduler {
+	public:
+		using Duration = typename Clock::duration;
+		using TimePoint = typename Clock::time_point;
+
+		// tick: the resolution of the wheel, the time starts at clock.now()
+		explicit TimerScheduler(Duration tick = std::chrono::milliseconds(1), Clock clock = {});
+
+		TimerScheduler(const TimerScheduler&) = delete;
+		TimerScheduler& operator=(const TimerScheduler&) = delete;
+
+		// task() -> void, called once after delay
+		template<typename Task>
+		TimerHandle After(Duration delay, Task&& task);
+
+		// task() -> void or bool, called every period (the first call is after period)
+		// a periodic task stops when it returns false
+		template<typename Task>
+		TimerHandle Every(Duration period, Task&& task);
+
+		// a task can cancel itself and other tasks, return false if the handle is not scheduled
+		bool Cancel(TimerHandle handle) noexcept;
+
+		bool IsScheduled(TimerHandle handle) const noexcept;
+
+		// advance to clock.now(), return the number of called tasks
+		std::size_t Update();
+
+		// advance to time, return the number of called tasks
+		// the ticks at which no slot comes due are skipped, so the cost depends on the scheduled tasks, not on the elapsed ticks
+		std::size_t AdvanceTo(TimePoint time);
+
+		TimePoint Now() const noexcept { return origin + tick * static_cast<typename Duration::rep>(now); }
+
+		Duration Tick() const noexcept { return tick; }
+
+		// the number of scheduled tasks
+		std::size_t Size() const noexcept { return numScheduled; }
+
+	private:
+		static constexpr std::size_t SlotBits = 6;
+		static constexpr std::size_t NumSlots = std::size_t{ 1 } << SlotBits;
+		static constexpr std::size_t NumLevels = 4;
+		static constexpr std::uint64_t MaxDelta = (std::uint64_t{ 1 } << (SlotBits * NumLevels)) - 1;
+		static constexpr std::size_t SlabSize = 256;
+		static constexpr std::uint32_t Null = static_cast<std::uint32_t>(-1);
+
+		enum class State : std::uint8_t { Free, Pending, Firing, Cancelled };
+
+		struct Entry {
+			unique_function<bool()> task;
+			std::uint64_t expiry; // in ticks
+			std::uint64_t period; // in ticks, 0 for a one-shot task
+			std::uint32_t prev;
+			std::uint32_t next; // the next free entry if state is Free
+			std::uint32_t generation{ 1 };
+			std::uint16_t slot; // level * NumSlots + the index in the level
+			State state{ State::Free };
+		};
+
+		std::uint64_t ToTicks(Duration duration) const noexcept;
+		TimerHandle Schedule(std::uint64_t delay, std::uint64_t period, unique_function<bool()> task);
+		Entry& Get(std::uint32_t index) const noexcept { return slabs[index / SlabSize][index % SlabSize]; }
+		std::uint32_t Allocate();
+		void Free(std::uint32_t index) noexcept;
+		void Place(std::uint32_t index) noexcept;
+		void Unlink(std::uint32_t index) noexcept;
+		void Cascade(std::size_t level) noexcept;
+		// the first tick after now at which a non-empty slot is called or cascaded
+		std::uint64_t NextDue() const noexcept;
+		std::size_t Step();
+
+		Duration tick;
+		Clock clock;
+		TimePoint origin;
+		std::uint64_t now{ 0 }; // the last processed tick
+
+		std::array<std::uint32_t, NumLevels * NumSlots> heads;
+		std::array<std::uint64_t, NumLevels> occupied{}; // a bit per non-empty slot of each level
+		std::vector<std::unique_ptr<Entry[]>> slabs;
+		std::uint32_t numEntries{ 0 };
+		std::uint32_t freeList{ Null };
+		std::size_t numScheduled{ 0 };
+	};
+}
+
+#include "details/TimerScheduler.inl"
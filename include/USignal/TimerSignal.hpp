@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Signal.hpp"
+#include "TimerScheduler.hpp"
+
+#include <tuple>
+
+namespace Ubpa {
+	template<typename Func, typename Clock = std::chrono::steady_clock>
+	class TimerSignal;
+
+	// a signal with delayed and periodic emissions scheduled on a TimerScheduler
+	// the scheduled emissions copy the arguments and track the signal (like TrackedConnection),
+	// so the signal can be moved, and its emissions are dropped after it is destroyed
+	// Args must be copyable values or const references
+	template<typename... Args, typename Clock>
+	class TimerSignal<void(Args...), Clock> : protected Signal<void(Args...)> {
+		static_assert(((!std::is_reference_v<Args> || std::is_const_v<std::remove_reference_t<Args>>) && ...),
+			"the arguments of TimerSignal must be values or const references");
+
+	public:
+		using Duration = typename TimerScheduler<Clock>::Duration;
+
+		using Signal<void(Args...)>::Connect;
+		using Signal<void(Args...)>::ScopeConnect;
+		using Signal<void(Args...)>::ScopeConnectTracked;
+		using Signal<void(Args...)>::Disconnect;
+		using Signal<void(Args...)>::MoveInstance;
+		using Signal<void(Args...)>::Size;
+		using Signal<void(Args...)>::Empty;
+		using Signal<void(Args...)>::Emit;
+
+		explicit TimerSignal(TimerScheduler<Clock>& scheduler) noexcept : scheduler{ &scheduler } {}
+		TimerSignal(TimerSignal&&) noexcept = default;
+		TimerSignal& operator=(TimerSignal&&) noexcept = default;
+
+		// emit once after delay
+		TimerHandle EmitAfter(Duration delay, std::type_identity_t<Args>... args);
+
+		// emit every period until it is canceled or the signal is destroyed
+		TimerHandle EmitEvery(Duration period, std::type_identity_t<Args>... args);
+
+		bool Cancel(TimerHandle handle) noexcept { return scheduler->Cancel(handle); }
+
+		TimerScheduler<Clock>& GetScheduler() const noexcept { return *scheduler; }
+
+	private:
+		// task() -> bool, false if the signal is destroyed
+		auto MakeTask(std::type_identity_t<Args>... args);
+
+		TimerScheduler<Clock>* scheduler;
+	};
+}
+
+#include "details/TimerSignal.inl"
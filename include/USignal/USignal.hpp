@@ -1,5 +1,17 @@
 #pragma once
 
 #include "Connection.hpp"
+#include "EmissionCursor.hpp"
+#include "FixedCapacitySignal.hpp"
 #include "MSignal.hpp"
+#include "MultiSignal.hpp"
+#include "Operators.hpp"
+#include "Property.hpp"
+#include "ShardedSignal.hpp"
+#include "SharedSlot.hpp"
 #include "Signal.hpp"
+#include "SignalGroup.hpp"
+#include "SignalRegistry.hpp"
+#include "StickySignal.hpp"
+#include "TimerScheduler.hpp"
+#include "TimerSignal.hpp"
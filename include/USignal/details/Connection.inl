@@ -54,6 +54,21 @@ namespace Ubpa {
 		this->instance = instance;
 	}
 
+	template<typename Func>
+	void ScopedConnection<Func>::Relocate(const void* srcBegin, const void* srcEnd, void* dstBegin) noexcept {
+		// the instance may not point into the range, so the pointers are compared with std::less
+		if (!std::less<>{}(this->instance, srcBegin) && std::less<>{}(this->instance, srcEnd)) {
+			const auto offset = static_cast<const std::byte*>(this->instance) - static_cast<const std::byte*>(srcBegin);
+			this->instance = static_cast<std::byte*>(dstBegin) + offset;
+		}
+	}
+
+	template<typename Func>
+	void RelocateRange(std::span<ScopedConnection<Func>> connections, const void* srcBegin, const void* srcEnd, void* dstBegin) noexcept {
+		for (auto& connection : connections)
+			connection.Relocate(srcBegin, srcEnd, dstBegin);
+	}
+
 	template<typename Func>
 	void ScopedConnection<Func>::Release() {
 		if (signal) {
@@ -65,4 +80,67 @@ namespace Ubpa {
 
 	template<typename Func>
 	void ScopedConnection<Func>::Reset() noexcept { signal = nullptr; }
+
+	template<typename Func>
+	TrackedConnection<Func>::TrackedConnection() noexcept :
+		Connection{}, anchor{ nullptr } {}
+
+	template<typename Func>
+	TrackedConnection<Func>::TrackedConnection(const Connection& conn, details::SignalAnchor* anchor) noexcept :
+		Connection{ conn }, anchor{ anchor }
+	{
+		if (anchor)
+			details::AddRef(anchor);
+	}
+
+	template<typename Func>
+	TrackedConnection<Func>::TrackedConnection(TrackedConnection&& other) noexcept :
+		Connection{ std::move(other) }, anchor{ other.anchor } { other.anchor = nullptr; }
+
+	template<typename Func>
+	TrackedConnection<Func>::~TrackedConnection() { Release(); }
+
+	template<typename Func>
+	TrackedConnection<Func>& TrackedConnection<Func>::operator=(TrackedConnection&& rhs) noexcept {
+		TrackedConnection{ std::move(rhs) }.Swap(*this);
+		return *this;
+	}
+
+	template<typename Func>
+	void TrackedConnection<Func>::Swap(TrackedConnection& other) noexcept {
+		std::swap(anchor, other.anchor);
+		std::swap(static_cast<Connection&>(*this), static_cast<Connection&>(other));
+	}
+
+	template<typename Func>
+	Signal<Func>* TrackedConnection<Func>::GetSignal() const noexcept {
+		if (!anchor || !anchor->handle)
+			return nullptr;
+		return static_cast<Signal<Func>*>(anchor->handle);
+	}
+
+	template<typename Func>
+	void TrackedConnection<Func>::MoveInstance(void* instance) {
+		if (Signal<Func>* signal = GetSignal())
+			signal->MoveInstance(instance, this->instance);
+		this->instance = instance;
+	}
+
+	template<typename Func>
+	void TrackedConnection<Func>::Release() {
+		if (!anchor)
+			return;
+		if (Signal<Func>* signal = GetSignal())
+			signal->Disconnect(*this);
+		details::Unref(anchor);
+		anchor = nullptr;
+	}
+
+	template<typename Func>
+	void TrackedConnection<Func>::Reset() noexcept {
+		if (!anchor)
+			return;
+		details::Unref(anchor);
+		anchor = nullptr;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename... Args>
+	EmissionCursor<void(Args...)>::EmissionCursor(details::SignalAnchor* anchor, std::type_identity_t<Args>... args) :
+		anchor{ anchor }, args{ std::in_place, std::forward<Args>(args)... } {}
+
+	template<typename... Args>
+	bool EmissionCursor<void(Args...)>::Resume(std::chrono::nanoseconds budget) {
+		if (Done())
+			return true;
+		auto* signal = static_cast<Signal<void(Args...)>*>(anchor.Get());
+		if (!signal || signal->ResumeEmission(*this, std::chrono::steady_clock::now() + budget))
+			Cancel();
+		return Done();
+	}
+
+	template<typename... Args>
+	void EmissionCursor<void(Args...)>::Cancel() noexcept {
+		anchor = {};
+		args.reset();
+		last.reset();
+	}
+}
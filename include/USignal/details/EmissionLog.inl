@@ -0,0 +1,321 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Ubpa::details {
+	// log layout
+	// - EmissionLogHeader
+	// - chunks: std::uint64_t size, then size bytes of records
+	// - record: EmissionRecordHeader, then payloadSize bytes of serialized arguments
+	// a zero chunk size marks the end of the log
+	struct EmissionLogHeader {
+		static constexpr std::uint64_t Magic = 0x474F4C4C4E474953; // "SIGNLLOG"
+		std::uint64_t magic;
+		std::uint64_t size; // used bytes, including the header
+	};
+
+	struct EmissionRecordHeader {
+		std::uint64_t timestamp; // nanoseconds of std::chrono::steady_clock
+		std::uint32_t signalID;
+		std::uint32_t payloadSize;
+	};
+
+	inline std::uint64_t EmissionTimestamp() noexcept {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	// a serializer without Skip can't be checked
+	template<typename T>
+	bool SkipEmissionArg(const std::byte*& src, const std::byte* end) {
+		if constexpr (requires { { EmissionSerializer<T>::Skip(src, end) } -> std::convertible_to<bool>; })
+			return EmissionSerializer<T>::Skip(src, end);
+		else
+			return true;
+	}
+}
+
+namespace Ubpa {
+	inline std::byte* EmissionSerializer<std::string>::Write(std::byte* dst, const std::string& value) noexcept {
+		const std::uint64_t n = value.size();
+		std::memcpy(dst, &n, sizeof(std::uint64_t));
+		std::memcpy(dst + sizeof(std::uint64_t), value.data(), value.size());
+		return dst + sizeof(std::uint64_t) + value.size();
+	}
+
+	inline std::string EmissionSerializer<std::string>::Read(const std::byte*& src) {
+		std::uint64_t n;
+		std::memcpy(&n, src, sizeof(std::uint64_t));
+		std::string value(reinterpret_cast<const char*>(src + sizeof(std::uint64_t)), static_cast<std::size_t>(n));
+		src += sizeof(std::uint64_t) + n;
+		return value;
+	}
+
+	inline bool EmissionSerializer<std::string>::Skip(const std::byte*& src, const std::byte* end) noexcept {
+		if (static_cast<std::size_t>(end - src) < sizeof(std::uint64_t))
+			return false;
+		std::uint64_t n;
+		std::memcpy(&n, src, sizeof(std::uint64_t));
+		if (n > static_cast<std::size_t>(end - src) - sizeof(std::uint64_t))
+			return false;
+		src += sizeof(std::uint64_t) + n;
+		return true;
+	}
+
+	//
+	// EmissionRecorder
+	/////////////////////
+
+	inline EmissionRecorder::EmissionRecorder(const char* path, std::size_t capacity, std::size_t bufferSize) :
+		capacity{ capacity }, bufferSize{ bufferSize }, validEnd{ capacity }
+	{
+		assert(capacity > sizeof(details::EmissionLogHeader));
+		assert(bufferSize > sizeof(std::uint64_t) + sizeof(details::EmissionRecordHeader));
+
+		fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+			return;
+		if (::ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+			::close(fd);
+			fd = -1;
+			return;
+		}
+		void* addr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (addr == MAP_FAILED) {
+			::close(fd);
+			fd = -1;
+			return;
+		}
+		log = static_cast<std::byte*>(addr);
+		auto* header = reinterpret_cast<details::EmissionLogHeader*>(log);
+		header->magic = details::EmissionLogHeader::Magic;
+		header->size = sizeof(details::EmissionLogHeader);
+	}
+
+	inline EmissionRecorder::~EmissionRecorder() { Close(); }
+
+	template<typename... Ts>
+	void EmissionRecorder::Record(std::uint32_t signalID, const Ts&... args) {
+		if (!log)
+			return;
+
+		const std::size_t payloadSize = (std::size_t{ 0 } + ... + EmissionSerializer<Ts>::Size(args));
+		const std::size_t recordSize = sizeof(details::EmissionRecordHeader) + payloadSize;
+
+		ThreadBuffer& buffer = GetThreadBuffer();
+		if (buffer.data.size() + recordSize > bufferSize)
+			FlushBuffer(buffer);
+
+		const std::size_t offset = buffer.data.size();
+		buffer.data.resize(offset + recordSize);
+		std::byte* cursor = buffer.data.data() + offset;
+
+		const details::EmissionRecordHeader header{
+			details::EmissionTimestamp(),
+			signalID,
+			static_cast<std::uint32_t>(payloadSize)
+		};
+		std::memcpy(cursor, &header, sizeof(details::EmissionRecordHeader));
+		cursor += sizeof(details::EmissionRecordHeader);
+		((cursor = EmissionSerializer<Ts>::Write(cursor, args)), ...);
+		assert(cursor == buffer.data.data() + buffer.data.size());
+		++buffer.numRecords;
+
+		// an oversize record is written at once
+		if (buffer.data.size() > bufferSize)
+			FlushBuffer(buffer);
+	}
+
+	template<typename Ret, typename... Args>
+	void EmissionRecorder::Emit(std::uint32_t signalID, Signal<Ret(Args...)>& signal, std::type_identity_t<Args>... args) {
+		Record<std::remove_cvref_t<Args>...>(signalID, args...);
+		signal.Emit(std::forward<Args>(args)...);
+	}
+
+	inline EmissionRecorder::ThreadBuffer& EmissionRecorder::GetThreadBuffer() {
+		struct Cache {
+			std::uint64_t recorderID{ 0 };
+			ThreadBuffer* buffer{ nullptr };
+		};
+		static thread_local Cache cache;
+		if (cache.recorderID == id)
+			return *cache.buffer;
+
+		const auto owner = std::this_thread::get_id();
+		std::lock_guard<std::mutex> lock(mutex);
+		auto target = std::find_if(buffers.begin(), buffers.end(), [owner](const auto& buffer) {
+			return buffer->owner == owner;
+		});
+		if (target == buffers.end()) {
+			auto buffer = std::make_unique<ThreadBuffer>();
+			buffer->owner = owner;
+			buffer->data.reserve(bufferSize);
+			buffer->data.resize(sizeof(std::uint64_t)); // chunk size
+			buffers.push_back(std::move(buffer));
+			target = buffers.end() - 1;
+		}
+		cache.recorderID = id;
+		cache.buffer = target->get();
+		return *cache.buffer;
+	}
+
+	inline void EmissionRecorder::FlushBuffer(ThreadBuffer& buffer) {
+		const std::uint64_t chunkSize = buffer.data.size() - sizeof(std::uint64_t);
+		if (chunkSize == 0)
+			return;
+		std::memcpy(buffer.data.data(), &chunkSize, sizeof(std::uint64_t));
+
+		auto* header = reinterpret_cast<details::EmissionLogHeader*>(log);
+		const std::uint64_t n = buffer.data.size();
+		const std::uint64_t offset = std::atomic_ref<std::uint64_t>(header->size).fetch_add(n, std::memory_order_relaxed);
+		if (offset + n <= capacity)
+			std::memcpy(log + offset, buffer.data.data(), n);
+		else {
+			// the log is full, everything after offset is invalid
+			std::uint64_t end = validEnd.load(std::memory_order_relaxed);
+			while (offset < end && !validEnd.compare_exchange_weak(end, offset, std::memory_order_relaxed)) {}
+			numDropped.fetch_add(buffer.numRecords, std::memory_order_relaxed);
+		}
+
+		buffer.numRecords = 0;
+		buffer.data.resize(sizeof(std::uint64_t));
+	}
+
+	inline void EmissionRecorder::Flush() {
+		if (!log)
+			return;
+		std::lock_guard<std::mutex> lock(mutex);
+		for (const auto& buffer : buffers)
+			FlushBuffer(*buffer);
+	}
+
+	inline void EmissionRecorder::Close() {
+		if (!log)
+			return;
+		Flush();
+		auto* header = reinterpret_cast<details::EmissionLogHeader*>(log);
+		const std::uint64_t size = std::min<std::uint64_t>(header->size, validEnd.load(std::memory_order_relaxed));
+		header->size = size;
+		::msync(log, capacity, MS_SYNC);
+		::munmap(log, capacity);
+		[[maybe_unused]] const int rst = ::ftruncate(fd, static_cast<off_t>(size));
+		::close(fd);
+		log = nullptr;
+		fd = -1;
+		buffers.clear();
+	}
+
+	//
+	// EmissionReplayer
+	/////////////////////
+
+	inline EmissionReplayer::EmissionReplayer(const char* path) {
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat info;
+		if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(details::EmissionLogHeader)) {
+			::close(fd);
+			return;
+		}
+		size = static_cast<std::size_t>(info.st_size);
+		void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (addr == MAP_FAILED)
+			return;
+
+		details::EmissionLogHeader header;
+		std::memcpy(&header, addr, sizeof(details::EmissionLogHeader));
+		if (header.magic != details::EmissionLogHeader::Magic) {
+			::munmap(addr, size);
+			return;
+		}
+		log = static_cast<const std::byte*>(addr);
+
+		malformed = header.size < sizeof(details::EmissionLogHeader);
+		const std::size_t end = std::min<std::size_t>(size, header.size);
+		std::size_t offset = sizeof(details::EmissionLogHeader);
+		// sizes are compared with the remaining bytes, so a corrupted size can't overflow the offset
+		while (!malformed && end - offset >= sizeof(std::uint64_t)) {
+			std::uint64_t chunkSize;
+			std::memcpy(&chunkSize, log + offset, sizeof(std::uint64_t));
+			offset += sizeof(std::uint64_t);
+			if (chunkSize == 0)
+				break;
+			if (chunkSize > end - offset) {
+				malformed = true;
+				break;
+			}
+			const std::size_t chunkEnd = offset + static_cast<std::size_t>(chunkSize);
+			while (offset < chunkEnd) {
+				details::EmissionRecordHeader record;
+				if (chunkEnd - offset < sizeof(details::EmissionRecordHeader)) {
+					malformed = true;
+					break;
+				}
+				std::memcpy(&record, log + offset, sizeof(details::EmissionRecordHeader));
+				offset += sizeof(details::EmissionRecordHeader);
+				if (record.payloadSize > chunkEnd - offset) {
+					malformed = true;
+					break;
+				}
+				records.push_back(Record{ record.timestamp, record.signalID, record.payloadSize, log + offset });
+				offset += record.payloadSize;
+			}
+		}
+		// the file is shorter than the header says if it is truncated
+		malformed = malformed || header.size > size;
+
+		// chunks of different threads interleave
+		std::stable_sort(records.begin(), records.end(), [](const Record& lhs, const Record& rhs) {
+			return lhs.timestamp < rhs.timestamp;
+		});
+	}
+
+	inline EmissionReplayer::~EmissionReplayer() {
+		if (log)
+			::munmap(const_cast<std::byte*>(log), size);
+	}
+
+	template<typename Ret, typename... Args>
+	void EmissionReplayer::Bind(std::uint32_t signalID, Signal<Ret(Args...)>& signal) {
+		handlers.erase(signalID);
+		handlers.emplace(signalID, [&signal](const std::byte* payload, const std::byte* end) {
+			const std::byte* cursor = payload;
+			if (!(details::SkipEmissionArg<std::remove_cvref_t<Args>>(cursor, end) && ...))
+				return false;
+			// braced initialization evaluates the reads in order
+			std::tuple<std::remove_cvref_t<Args>...> values{ EmissionSerializer<std::remove_cvref_t<Args>>::Read(payload)... };
+			std::apply([&signal](auto&... values) {
+				signal.Emit(std::forward<Args>(values)...);
+			}, values);
+			return true;
+		});
+	}
+
+	inline std::size_t EmissionReplayer::Replay(double speed) {
+		if (records.empty())
+			return 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		const std::uint64_t first = records.front().timestamp;
+		std::size_t cnt = 0;
+		for (const auto& record : records) {
+			auto target = handlers.find(record.signalID);
+			if (target == handlers.end())
+				continue;
+			if (speed > 0.) {
+				const auto delay = static_cast<std::int64_t>(static_cast<double>(record.timestamp - first) / speed);
+				std::this_thread::sleep_until(start + std::chrono::nanoseconds(delay));
+			}
+			if (target->second(record.payload, record.payload + record.payloadSize))
+				++cnt;
+			else
+				malformed = true;
+		}
+		return cnt;
+	}
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	FixedCapacitySignal<Ret(Args...), N, InlineBytes>::FixedCapacitySignal(FixedCapacitySignal&& other) noexcept :
+		innerID{ other.innerID }, size{ other.size }
+	{
+		assert(!other.isEmitting);
+		for (std::size_t i = 0; i < size; i++) {
+			entries[i].connection = other.entries[i].connection;
+			entries[i].slot = std::move(other.entries[i].slot);
+		}
+		other.size = 0;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	FixedCapacitySignal<Ret(Args...), N, InlineBytes>&
+		FixedCapacitySignal<Ret(Args...), N, InlineBytes>::operator=(FixedCapacitySignal&& rhs) noexcept
+	{
+		if (this != &rhs) {
+			Clear();
+			assert(!rhs.isEmitting);
+			innerID = rhs.innerID;
+			size = rhs.size;
+			for (std::size_t i = 0; i < size; i++) {
+				entries[i].connection = rhs.entries[i].connection;
+				entries[i].slot = std::move(rhs.entries[i].slot);
+			}
+			rhs.size = 0;
+		}
+		return *this;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	auto FixedCapacitySignal<Ret(Args...), N, InlineBytes>::LowerBound(const Connection& connection) noexcept -> Entry* {
+		return std::lower_bound(Begin(), End(), connection, [](const Entry& lhs, const Connection& rhs) {
+			return lhs.connection < rhs;
+		});
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	auto FixedCapacitySignal<Ret(Args...), N, InlineBytes>::LowerBound(const void* instance) noexcept -> Entry* {
+		return std::lower_bound(Begin(), End(), instance, [](const Entry& lhs, const void* rhs) {
+			return lhs.connection < rhs;
+		});
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename Slot>
+	std::optional<Connection> FixedCapacitySignal<Ret(Args...), N, InlineBytes>::ConnectImpl(const Connection& connection, Slot&& slot) {
+		if constexpr (std::is_invocable_r_v<Ret, std::decay_t<Slot>&, void*, Args...>) {
+			if (size == N)
+				return std::nullopt;
+			Entry* target = LowerBound(connection);
+			if (target != End() && target->connection == connection)
+				return std::nullopt;
+			for (Entry* cursor = End(); cursor != target; --cursor) {
+				cursor->connection = (cursor - 1)->connection;
+				cursor->slot = std::move((cursor - 1)->slot);
+			}
+			target->connection = connection;
+			target->slot = details::InplaceFunction<FuncSig, InlineBytes>(std::forward<Slot>(slot));
+			++size;
+			return connection;
+		}
+		else
+			return ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template get(std::forward<Slot>(slot)));
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename Slot>
+	std::optional<Connection> FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Connect(Slot&& slot) {
+		static_assert(!std::is_pointer_v<Slot>);
+		assert(!isEmitting);
+		Connection connection{ nullptr, reinterpret_cast<FuncSig*>(innerID) };
+		auto rst = ConnectImpl(connection, std::forward<Slot>(slot));
+		if (rst)
+			++innerID;
+		return rst;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<auto funcptr>
+	std::optional<Connection> FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Connect() {
+		static_assert(std::is_function_v<std::remove_pointer_t<decltype(funcptr)>>);
+		assert(!isEmitting);
+		return ConnectImpl(Connection{ nullptr, funcptr }, details::SlotExpand<Ret(Args...)>::template get<funcptr>());
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<auto memslot, typename T>
+	std::optional<Connection> FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Connect(T* obj) {
+		static_assert(memslot != nullptr);
+		using MemSlot = decltype(memslot);
+		static_assert(std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>);
+		assert(obj);
+		assert(!isEmitting);
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
+		assert(instance);
+		return ConnectImpl(Connection{ instance, memslot }, details::SlotExpand<Ret(Args...)>::template mem_get<memslot>());
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename MemSlot, typename T>
+	std::optional<Connection> FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Connect(MemSlot&& memslot, T* obj) {
+		assert(obj);
+		assert(!isEmitting);
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
+		assert(instance);
+
+		if constexpr (std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>) {
+			assert(memslot);
+			Connection connection{ instance, memslot };
+			return ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template mem_get(std::forward<MemSlot>(memslot)));
+		}
+		else {
+			Connection connection{ instance, reinterpret_cast<FuncSig*>(innerID) };
+			auto rst = ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template mem_get(std::forward<MemSlot>(memslot)));
+			if (rst)
+				++innerID;
+			return rst;
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Erase(Entry* first, Entry* last) noexcept {
+		if (first == last)
+			return;
+		Entry* end = End();
+		Entry* cursor = first;
+		for (Entry* src = last; src != end; ++src, ++cursor) {
+			cursor->connection = src->connection;
+			cursor->slot = std::move(src->slot);
+		}
+		for (; cursor != end; ++cursor)
+			cursor->slot.Reset();
+		size -= static_cast<std::size_t>(last - first);
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Disconnect(const Connection& connection) noexcept {
+		assert(!isEmitting);
+		Entry* target = LowerBound(connection);
+		if (target != End() && target->connection == connection)
+			Erase(target, target + 1);
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename T>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Disconnect(const T* ptr) noexcept {
+		assert(!isEmitting);
+		if constexpr (std::is_function_v<T>)
+			Disconnect(Connection{ nullptr, ptr });
+		else {
+			Entry* first = LowerBound(static_cast<const void*>(ptr));
+			Entry* last = first;
+			while (last != End() && last->connection.instance == ptr)
+				++last;
+			Erase(first, last);
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<auto memslot>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Disconnect(const details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>* obj) noexcept {
+		Disconnect(Connection{ const_cast<details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>*>(obj), memslot });
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Emit(Args... args) {
+		assert(!isEmitting);
+		isEmitting = true;
+		for (Entry* cursor = Begin(); cursor != End(); ++cursor) {
+			assert(cursor->slot);
+			cursor->slot(cursor->connection.instance, std::forward<Args>(args)...);
+		}
+		isEmitting = false;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename Acc> requires std::negation_v<std::is_void<Ret>>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Emit(Acc&& acc, Args... args) {
+		assert(!isEmitting);
+		isEmitting = true;
+		for (Entry* cursor = Begin(); cursor != End(); ++cursor) {
+			assert(cursor->slot);
+			acc(cursor->slot(cursor->connection.instance, std::forward<Args>(args)...));
+		}
+		isEmitting = false;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	template<typename T>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::MoveInstance(T* dst, const T* src) noexcept {
+		assert(!isEmitting);
+		if (dst == src)
+			return;
+		Entry* first = LowerBound(static_cast<const void*>(src));
+		Entry* last = first;
+		while (last != End() && last->connection.instance == src)
+			++last;
+		// as in Signal::MoveInstance, the connections dst already has keep their slots
+		Entry* kept = first;
+		for (Entry* cursor = first; cursor != last; ++cursor) {
+			const Connection connection{ dst, cursor->connection.funcptr };
+			const Entry* existing = LowerBound(connection);
+			if (existing != End() && existing->connection == connection)
+				continue;
+			if (kept != cursor) {
+				kept->connection = cursor->connection;
+				kept->slot = std::move(cursor->slot);
+			}
+			++kept;
+		}
+		Erase(kept, last);
+		last = kept;
+		if (first == last)
+			return;
+		// rename the instance of [first, last), then rotate the range to its new sorted place
+		for (Entry* cursor = first; cursor != last; ++cursor)
+			cursor->connection.instance = dst;
+		if (dst < src) {
+			Entry* target = std::lower_bound(Begin(), first, static_cast<const void*>(dst), [](const Entry& lhs, const void* rhs) {
+				return lhs.connection < rhs;
+			});
+			std::rotate(target, first, last);
+		}
+		else {
+			Entry* target = std::lower_bound(last, End(), static_cast<const void*>(dst), [](const Entry& lhs, const void* rhs) {
+				return lhs.connection < rhs;
+			});
+			std::rotate(first, last, target);
+		}
+		// dst may have had connections, keep the connections of dst sorted
+		Entry* dstFirst = LowerBound(static_cast<const void*>(dst));
+		Entry* dstLast = dstFirst;
+		while (dstLast != End() && dstLast->connection.instance == dst)
+			++dstLast;
+		std::sort(dstFirst, dstLast, [](const Entry& lhs, const Entry& rhs) {
+			return lhs.connection < rhs.connection;
+		});
+	}
+
+	template<typename Ret, typename... Args, std::size_t N, std::size_t InlineBytes>
+	void FixedCapacitySignal<Ret(Args...), N, InlineBytes>::Clear() noexcept {
+		assert(!isEmitting);
+		for (Entry* cursor = Begin(); cursor != End(); ++cursor)
+			cursor->slot.Reset();
+		size = 0;
+	}
+}
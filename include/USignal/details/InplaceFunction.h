@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ubpa::details {
+	template<typename Func, std::size_t Capacity>
+	class InplaceFunction;
+
+	// a move-only type-erased callable object stored in a fixed inline buffer
+	// it never allocates, a callable object larger than Capacity is rejected at compile time
+	template<typename Ret, typename... Args, std::size_t Capacity>
+	class InplaceFunction<Ret(Args...), Capacity> {
+		static_assert(Capacity > 0);
+
+	public:
+		InplaceFunction() noexcept = default;
+
+		template<typename F> requires std::negation_v<std::is_same<std::decay_t<F>, InplaceFunction>>
+		InplaceFunction(F&& func) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F>) {
+			using T = std::decay_t<F>;
+			static_assert(sizeof(T) <= Capacity, "the callable object is too large for the inline buffer");
+			static_assert(alignof(T) <= alignof(std::max_align_t), "the callable object is over-aligned");
+			static_assert(std::is_nothrow_move_constructible_v<T>);
+			new(storage)T(std::forward<F>(func));
+			invoker = [](void* storage, Args... args) -> Ret {
+				if constexpr (std::is_void_v<Ret>)
+					(*static_cast<T*>(storage))(std::forward<Args>(args)...);
+				else
+					return (*static_cast<T*>(storage))(std::forward<Args>(args)...);
+			};
+			// src == nullptr: destroy dst
+			// else: move src to dst, then destroy src
+			manager = [](void* dst, void* src) noexcept {
+				if (src) {
+					new(dst)T(std::move(*static_cast<T*>(src)));
+					static_cast<T*>(src)->~T();
+				}
+				else
+					static_cast<T*>(dst)->~T();
+			};
+		}
+
+		InplaceFunction(InplaceFunction&& other) noexcept :
+			invoker{ other.invoker }, manager{ other.manager }
+		{
+			if (manager)
+				manager(storage, other.storage);
+			other.invoker = nullptr;
+			other.manager = nullptr;
+		}
+
+		InplaceFunction& operator=(InplaceFunction&& rhs) noexcept {
+			if (this != &rhs) {
+				Reset();
+				invoker = rhs.invoker;
+				manager = rhs.manager;
+				if (manager)
+					manager(storage, rhs.storage);
+				rhs.invoker = nullptr;
+				rhs.manager = nullptr;
+			}
+			return *this;
+		}
+
+		~InplaceFunction() { Reset(); }
+
+		void Reset() noexcept {
+			if (manager)
+				manager(storage, nullptr);
+			invoker = nullptr;
+			manager = nullptr;
+		}
+
+		Ret operator()(Args... args) {
+			return invoker(storage, std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const noexcept { return invoker != nullptr; }
+
+		InplaceFunction(const InplaceFunction&) = delete;
+		InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+	private:
+		alignas(std::max_align_t) std::byte storage[Capacity];
+		Ret(*invoker)(void*, Args...) { nullptr };
+		void(*manager)(void*, void*) noexcept { nullptr };
+	};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename... Funcs>
+	template<auto... memslots, typename T>
+	bool MultiSignal<Funcs...>::Connect(T* obj) {
+		static_assert(sizeof...(memslots) == sizeof...(Funcs), "MultiSignal::Connect needs one memslot (or nullptr) per signature");
+		assert(!isEmitting);
+		static_assert(!(std::is_null_pointer_v<decltype(memslots)> && ...), "MultiSignal::Connect needs a memslot");
+		assert(obj);
+		void* instance = nullptr;
+		for (void* adjusted : { details::MultiSlotInstance<memslots>(obj)... }) {
+			assert(!adjusted || !instance || adjusted == instance);
+			if (adjusted)
+				instance = adjusted;
+		}
+		auto [iter, inserted] = receivers.emplace(instance, &table<memslots...>);
+		if (!inserted)
+			iter->second = &table<memslots...>;
+		return inserted;
+	}
+
+	template<typename... Funcs>
+	void MultiSignal<Funcs...>::Disconnect(const void* obj) {
+		assert(!isEmitting);
+		auto target = receivers.find(obj);
+		if (target != receivers.end())
+			receivers.erase(target);
+	}
+
+	template<typename... Funcs>
+	template<typename T>
+	void MultiSignal<Funcs...>::MoveInstance(T* dst, const T* src) {
+		assert(!isEmitting);
+		auto target = receivers.find(src);
+		if (target == receivers.end())
+			return;
+		const Table* t = target->second;
+		receivers.erase(target);
+		[[maybe_unused]] const bool inserted = receivers.emplace(static_cast<void*>(dst), t).second;
+		assert(inserted);
+	}
+
+	template<typename... Funcs>
+	template<std::size_t I, typename... Ts>
+	void MultiSignal<Funcs...>::Emit(Ts&&... args) {
+		static_assert(I < sizeof...(Funcs));
+		assert(!isEmitting);
+		isEmitting = true;
+		details::MultiSlot<std::tuple_element_t<I, std::tuple<Funcs...>>>::template Emit<I>(receivers, std::forward<Ts>(args)...);
+		isEmitting = false;
+	}
+
+	template<typename... Funcs>
+	std::size_t MultiSignal<Funcs...>::MemoryUsage() const noexcept {
+		std::size_t usage = sizeof(MultiSignal);
+		// the first 16 receivers are stored in the signal
+		if (receivers.capacity() > 16)
+			usage += receivers.capacity() * sizeof(typename decltype(receivers)::value_type);
+		return usage;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+namespace Ubpa::details {
+	template<typename T>
+	struct IsFilterOp : std::false_type {};
+	template<typename Pred>
+	struct IsFilterOp<FilterOp<Pred>> : std::true_type {};
+
+	// run the stages from I, then call the sink
+	template<std::size_t I, typename StageTuple, typename Sink, typename... Values>
+	void RunSignalPipe(StageTuple& stages, Sink& sink, Values&&... values) {
+		if constexpr (I == std::tuple_size_v<StageTuple>)
+			sink(std::forward<Values>(values)...);
+		else {
+			auto& stage = std::get<I>(stages);
+			if constexpr (IsFilterOp<std::remove_cvref_t<decltype(stage)>>::value) {
+				if (stage.pred(values...))
+					RunSignalPipe<I + 1>(stages, sink, std::forward<Values>(values)...);
+			}
+			else
+				RunSignalPipe<I + 1>(stages, sink, stage.fn(std::forward<Values>(values)...));
+		}
+	}
+
+	template<typename... Args, typename... Stages>
+	template<typename Stage>
+	SignalPipe<void(Args...), Stages..., Stage> SignalPipe<void(Args...), Stages...>::Append(Stage&& stage) && {
+		return { source, std::tuple_cat(std::move(stages), std::make_tuple(std::forward<Stage>(stage))) };
+	}
+
+	template<typename... Args, typename... Stages>
+	template<typename Sink>
+	Connection SignalPipe<void(Args...), Stages...>::Connect(Sink&& sink) && {
+		return source.Connect([stages = std::move(stages), sink = std::forward<Sink>(sink)](Args... args) mutable {
+			RunSignalPipe<0>(stages, sink, std::forward<Args>(args)...);
+		});
+	}
+}
+
+namespace Ubpa {
+	template<typename Ret, typename... Args>
+	auto Into(Signal<Ret(Args...)>& target) {
+		return Into([&target](auto&&... values) {
+			target.Emit(std::forward<decltype(values)>(values)...);
+		});
+	}
+
+	template<typename... Args, typename Pred>
+	auto operator|(Signal<void(Args...)>& source, details::FilterOp<Pred> op) {
+		return details::SignalPipe<void(Args...), details::FilterOp<Pred>>{ source, std::make_tuple(std::move(op)) };
+	}
+
+	template<typename... Args, typename Fn>
+	auto operator|(Signal<void(Args...)>& source, details::MapOp<Fn> op) {
+		return details::SignalPipe<void(Args...), details::MapOp<Fn>>{ source, std::make_tuple(std::move(op)) };
+	}
+
+	template<typename... Args, typename Sink>
+	Connection operator|(Signal<void(Args...)>& source, details::IntoOp<Sink> op) {
+		return details::SignalPipe<void(Args...)>{ source, {} }.Connect(std::move(op.sink));
+	}
+
+	template<typename Func, typename... Stages, typename Pred>
+	auto operator|(details::SignalPipe<Func, Stages...>&& pipe, details::FilterOp<Pred> op) {
+		return std::move(pipe).Append(std::move(op));
+	}
+
+	template<typename Func, typename... Stages, typename Fn>
+	auto operator|(details::SignalPipe<Func, Stages...>&& pipe, details::MapOp<Fn> op) {
+		return std::move(pipe).Append(std::move(op));
+	}
+
+	template<typename Func, typename... Stages, typename Sink>
+	Connection operator|(details::SignalPipe<Func, Stages...>&& pipe, details::IntoOp<Sink> op) {
+		return std::move(pipe).Connect(std::move(op.sink));
+	}
+}
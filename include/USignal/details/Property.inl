@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+namespace Ubpa::details {
+	inline ReactiveNode::~ReactiveNode() {
+		assert(observers.empty());
+		auto& context = ReactiveContext::Instance();
+		if (enqueued || context.flushing)
+			std::replace(context.queue.begin(), context.queue.end(), this, static_cast<ReactiveNode*>(nullptr));
+	}
+
+	inline void ReactiveNode::Mark(State newState) {
+		if (state >= newState)
+			return;
+		const bool wasClean = state == State::Clean;
+		state = newState;
+		if (!wasClean)
+			return; // the descendants are marked
+		if (IsObserved())
+			Enqueue();
+		for (ReactiveNode* observer : observers)
+			observer->Mark(State::Check);
+	}
+
+	inline void ReactiveNode::Enqueue() {
+		if (enqueued)
+			return;
+		enqueued = true;
+		ReactiveContext::Instance().queue.push_back(this);
+	}
+
+	inline void ReactiveNode::FlushIfIdle() {
+		auto& context = ReactiveContext::Instance();
+		if (context.batchDepth > 0 || context.flushing)
+			return;
+		context.flushing = true;
+		// the slots may set properties, the new nodes are flushed in the next round
+		// the nodes stay in the queue while they are flushed, a destroyed node is replaced by nullptr
+		std::size_t begin = 0;
+		while (begin < context.queue.size()) {
+			const std::size_t end = context.queue.size();
+			// the sources are notified before the observers
+			std::stable_sort(context.queue.begin() + begin, context.queue.begin() + end,
+				[](const ReactiveNode* lhs, const ReactiveNode* rhs) { return lhs->rank < rhs->rank; });
+			for (std::size_t i = begin; i < end; i++) {
+				ReactiveNode* node = context.queue[i];
+				if (!node)
+					continue;
+				node->enqueued = false;
+				node->UpdateIfNecessary();
+				node->Notify();
+			}
+			begin = end;
+		}
+		context.queue.clear();
+		context.flushing = false;
+	}
+}
+
+namespace Ubpa {
+	template<typename T>
+	void Property<T>::Set(T newValue) {
+		if constexpr (std::equality_comparable<T>) {
+			if (newValue == value)
+				return;
+		}
+		value = std::move(newValue);
+		for (ReactiveNode* observer : observers)
+			observer->Mark(State::Dirty);
+		if (IsObserved())
+			Enqueue();
+		FlushIfIdle();
+	}
+
+	template<typename T>
+	template<typename Func, typename... Sources>
+	Computed<T>::Computed(Func&& func, Sources&... inputs) :
+		// Clean until a source changes, the value is computed by the first update
+		ReactiveNode{ 1 + std::max({ std::uint32_t{ 0 }, static_cast<details::ReactiveNode&>(inputs).rank... }), State::Clean },
+		changed{ this },
+		compute{ [func = std::decay_t<Func>(std::forward<Func>(func)), &inputs...]() mutable -> T {
+			return func(inputs.Get()...);
+		} },
+		sources{ static_cast<details::ReactiveNode*>(&inputs)... }
+	{
+		static_assert((std::is_base_of_v<details::ReactiveNode, Sources> && ...),
+			"the sources of Computed must be Property or Computed");
+		for (ReactiveNode* source : sources)
+			source->observers.push_back(this);
+	}
+
+	template<typename T>
+	Computed<T>::~Computed() {
+		for (ReactiveNode* source : sources)
+			std::erase(source->observers, static_cast<ReactiveNode*>(this));
+	}
+
+	template<typename T>
+	const T& Computed<T>::Get() {
+		UpdateIfNecessary();
+		return *value;
+	}
+
+	template<typename T>
+	void Computed<T>::UpdateIfNecessary() {
+		if (!value)
+			state = State::Dirty;
+		else if (state == State::Check) {
+			for (ReactiveNode* source : sources) {
+				source->UpdateIfNecessary();
+				if (state == State::Dirty)
+					break; // a source changed
+			}
+		}
+		if (state == State::Dirty) {
+			T newValue = compute();
+			bool equal = false;
+			if constexpr (std::equality_comparable<T>)
+				equal = value.has_value() && *value == newValue;
+			if (!equal) {
+				value.emplace(std::move(newValue));
+				changedSinceNotify = IsObserved();
+				for (ReactiveNode* observer : observers)
+					observer->Mark(State::Dirty);
+			}
+		}
+		state = State::Clean;
+	}
+
+	template<typename T>
+	void Computed<T>::Notify() {
+		if (!changedSinceNotify)
+			return;
+		changedSinceNotify = false;
+		changed.Emit(*value);
+	}
+
+	inline PropertyBatch::~PropertyBatch() {
+		auto& context = details::ReactiveContext::Instance();
+		assert(context.batchDepth > 0);
+		if (--context.batchDepth == 0)
+			details::ReactiveNode::FlushIfIdle();
+	}
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+namespace Ubpa::details {
+	// instance addresses are aligned, so we mix the bits before taking the remainder
+	inline std::size_t ShardHash(std::size_t value) noexcept {
+		std::uint64_t x = static_cast<std::uint64_t>(value);
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+		x ^= x >> 33;
+		return static_cast<std::size_t>(x);
+	}
+}
+
+namespace Ubpa {
+	template<typename Ret, typename... Args, std::size_t N>
+	std::size_t ShardedSignal<Ret(Args...), N>::ShardIndex(const void* instance) noexcept {
+		return details::ShardHash(reinterpret_cast<std::size_t>(instance)) % N;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	std::size_t ShardedSignal<Ret(Args...), N>::ShardIndex(const Connection& connection) noexcept {
+		if (connection.instance)
+			return ShardIndex(connection.instance);
+		std::size_t value = 0;
+		for (std::size_t data : connection.funcptr.data)
+			value ^= data;
+		return details::ShardHash(value) % N;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<typename Slot>
+	Connection ShardedSignal<Ret(Args...), N>::ConnectImpl(const Connection& connection, Slot&& slot) {
+		Shard& shard = shards[ShardIndex(connection)];
+		std::lock_guard<details::SpinMutex> lock(shard.mutex);
+		shard.signal.ConnectImpl(connection, std::forward<Slot>(slot));
+		return connection;
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<typename Slot>
+	Connection ShardedSignal<Ret(Args...), N>::Connect(Slot&& slot) {
+		static_assert(!std::is_pointer_v<Slot>);
+		const std::size_t id = innerID.fetch_add(1, std::memory_order_relaxed);
+		return ConnectImpl(Connection{ nullptr, reinterpret_cast<FuncSig*>(id) }, std::forward<Slot>(slot));
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<auto funcptr>
+	Connection ShardedSignal<Ret(Args...), N>::Connect() {
+		static_assert(std::is_function_v<std::remove_pointer_t<decltype(funcptr)>>);
+		return ConnectImpl(Connection{ nullptr, funcptr }, details::SlotExpand<Ret(Args...)>::template get<funcptr>());
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<auto memslot, typename T>
+	Connection ShardedSignal<Ret(Args...), N>::Connect(T* obj) {
+		static_assert(memslot != nullptr);
+		using MemSlot = decltype(memslot);
+		static_assert(std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>);
+		assert(obj);
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
+		assert(instance);
+		return ConnectImpl(Connection{ instance, memslot }, details::SlotExpand<Ret(Args...)>::template mem_get<memslot>());
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<typename MemSlot, typename T>
+	Connection ShardedSignal<Ret(Args...), N>::Connect(MemSlot&& memslot, T* obj) {
+		assert(obj);
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
+		assert(instance);
+
+		details::FuncPtr funcptr;
+		if constexpr (std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>) {
+			assert(memslot);
+			funcptr = memslot;
+		}
+		else
+			funcptr = reinterpret_cast<FuncSig*>(innerID.fetch_add(1, std::memory_order_relaxed));
+
+		return ConnectImpl(Connection{ instance, funcptr },
+			details::SlotExpand<Ret(Args...)>::template mem_get(std::forward<MemSlot>(memslot)));
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	void ShardedSignal<Ret(Args...), N>::Disconnect(const Connection& connection) {
+		Shard& shard = shards[ShardIndex(connection)];
+		std::lock_guard<details::SpinMutex> lock(shard.mutex);
+		shard.signal.Disconnect(connection);
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<typename T>
+	void ShardedSignal<Ret(Args...), N>::Disconnect(const T* ptr) {
+		if constexpr (std::is_function_v<T>)
+			Disconnect(Connection{ nullptr, ptr });
+		else {
+			Shard& shard = shards[ShardIndex(static_cast<const void*>(ptr))];
+			std::lock_guard<details::SpinMutex> lock(shard.mutex);
+			shard.signal.Disconnect(ptr);
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<auto memslot>
+	void ShardedSignal<Ret(Args...), N>::Disconnect(const details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>* obj) {
+		Disconnect(Connection{ const_cast<details::ObjectTypeOfGeneralMemFunc_t<decltype(memslot)>*>(obj), memslot });
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	void ShardedSignal<Ret(Args...), N>::Emit(Args... args) {
+		for (Shard& shard : shards) {
+			std::lock_guard<details::SpinMutex> lock(shard.mutex);
+			shard.signal.Emit(std::forward<Args>(args)...);
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	template<typename Acc> requires std::negation_v<std::is_void<Ret>>
+	void ShardedSignal<Ret(Args...), N>::Emit(Acc&& acc, Args... args) {
+		for (Shard& shard : shards) {
+			std::lock_guard<details::SpinMutex> lock(shard.mutex);
+			shard.signal.Emit(acc, std::forward<Args>(args)...);
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	void ShardedSignal<Ret(Args...), N>::Clear() noexcept {
+		for (Shard& shard : shards) {
+			std::lock_guard<details::SpinMutex> lock(shard.mutex);
+			shard.signal.Clear();
+		}
+	}
+
+	template<typename Ret, typename... Args, std::size_t N>
+	std::size_t ShardedSignal<Ret(Args...), N>::Size() const noexcept {
+		std::size_t size = 0;
+		for (const Shard& shard : shards) {
+			std::lock_guard<details::SpinMutex> lock(shard.mutex);
+			size += shard.signal.Size();
+		}
+		return size;
+	}
+}
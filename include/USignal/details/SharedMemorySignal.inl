@@ -0,0 +1,287 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <climits>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Ubpa::details {
+	inline void FutexWait(std::atomic<std::uint32_t>* word, std::uint32_t value, std::chrono::nanoseconds timeout) noexcept {
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+		timespec ts{ static_cast<time_t>(seconds.count()), static_cast<long>((timeout - seconds).count()) };
+		// not FUTEX_PRIVATE_FLAG, the word is shared by processes
+		::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT, value, &ts, nullptr, 0);
+	}
+
+	inline void FutexWakeAll(std::atomic<std::uint32_t>* word) noexcept {
+		::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	template<typename T>
+	T ReadTrivial(const std::byte*& src) noexcept {
+		std::array<std::byte, sizeof(T)> bytes;
+		std::memcpy(bytes.data(), src, sizeof(T));
+		src += sizeof(T);
+		return std::bit_cast<T>(bytes);
+	}
+}
+
+namespace Ubpa {
+	// shared memory layout
+	// - Header
+	// - capacity entries
+	// the emission at position p is stored in entry p % capacity,
+	// its sequence is 2p + 1 while it is written and 2p + 2 after it is published
+	template<typename... Args>
+	struct SharedMemorySignal<void(Args...)>::Header {
+		static constexpr std::uint64_t Magic = 0x4C4E474953484D53; // "SMHSIGNL"
+		std::atomic<std::uint64_t> magic;
+		std::uint64_t payloadSize;
+		std::uint64_t entrySize;
+		std::uint64_t capacity;
+		alignas(64) std::atomic<std::uint64_t> writePosition;
+		alignas(64) std::atomic<std::uint32_t> futexWord; // changed by every emission
+		std::atomic<std::uint32_t> numSleepers;
+	};
+
+	template<typename... Args>
+	struct alignas(64) SharedMemorySignal<void(Args...)>::Entry {
+		std::atomic<std::uint64_t> sequence;
+		std::array<std::byte, PayloadSize> payload;
+	};
+
+	template<typename... Args>
+	SharedMemorySignal<void(Args...)>::SharedMemorySignal(const char* name, SharedMemoryRole role, std::size_t capacity) :
+		role{ role }, name{ name }
+	{
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free);
+
+		if (role == SharedMemoryRole::Publisher) {
+			assert(capacity > 0);
+			capacity = std::bit_ceil(capacity);
+			// O_EXCL: truncating a segment which is mapped by another publisher would crash its users (SIGBUS)
+			fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+			if (fd < 0)
+				return;
+			mappedSize = sizeof(Header) + capacity * sizeof(Entry);
+			if (::ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+				::close(fd);
+				fd = -1;
+				::shm_unlink(name);
+				return;
+			}
+		}
+		else {
+			fd = ::shm_open(name, O_RDWR, 0);
+			if (fd < 0)
+				return;
+			struct stat st;
+			if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+				::close(fd);
+				fd = -1;
+				return;
+			}
+			mappedSize = static_cast<std::size_t>(st.st_size);
+		}
+
+		void* addr = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (addr == MAP_FAILED) {
+			::close(fd);
+			fd = -1;
+			if (role == SharedMemoryRole::Publisher)
+				::shm_unlink(name);
+			return;
+		}
+
+		auto* mapped = static_cast<Header*>(addr);
+		if (role == SharedMemoryRole::Publisher) {
+			new(mapped)Header{};
+			mapped->payloadSize = PayloadSize;
+			mapped->entrySize = sizeof(Entry);
+			mapped->capacity = capacity;
+			auto* entries = reinterpret_cast<Entry*>(mapped + 1);
+			for (std::size_t i = 0; i < capacity; i++)
+				new(entries + i)Entry{};
+			mapped->magic.store(Header::Magic, std::memory_order_release);
+		}
+		else if (mapped->magic.load(std::memory_order_acquire) != Header::Magic
+			|| mapped->payloadSize != PayloadSize
+			|| mapped->entrySize != sizeof(Entry)
+			|| sizeof(Header) + mapped->capacity * sizeof(Entry) != mappedSize)
+		{
+			// not ready or created with other arguments
+			::munmap(addr, mappedSize);
+			::close(fd);
+			fd = -1;
+			return;
+		}
+		else
+			readPosition = mapped->writePosition.load(std::memory_order_acquire);
+
+		header = mapped;
+	}
+
+	template<typename... Args>
+	SharedMemorySignal<void(Args...)>::~SharedMemorySignal() {
+		Stop();
+		if (header)
+			::munmap(header, mappedSize);
+		if (fd >= 0) {
+			::close(fd);
+			if (role == SharedMemoryRole::Publisher)
+				::shm_unlink(name.c_str());
+		}
+	}
+
+	template<typename... Args>
+	auto SharedMemorySignal<void(Args...)>::GetEntry(std::uint64_t position) noexcept -> Entry& {
+		auto* entries = reinterpret_cast<Entry*>(header + 1);
+		return entries[position & (header->capacity - 1)];
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::Emit(std::type_identity_t<Args>... args) {
+		assert(IsOpen());
+		const std::uint64_t position = header->writePosition.fetch_add(1, std::memory_order_relaxed);
+		Entry& entry = GetEntry(position);
+
+		// wait for the emitting thread of the previous lap of this entry,
+		// only emitting threads of this publisher wait for each other, never for a subscriber
+		const std::uint64_t capacity = header->capacity;
+		const std::uint64_t prevSequence = position >= capacity ? 2 * (position - capacity) + 2 : 0;
+		while (entry.sequence.load(std::memory_order_acquire) != prevSequence)
+			std::this_thread::yield();
+
+		entry.sequence.store(2 * position + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::byte* dst = entry.payload.data();
+		((std::memcpy(dst, &args, sizeof(std::remove_cvref_t<Args>)), dst += sizeof(std::remove_cvref_t<Args>)), ...);
+		entry.sequence.store(2 * position + 2, std::memory_order_release);
+
+		// pairs with the sleeper: numSleepers++, then load futexWord
+		header->futexWord.fetch_add(1, std::memory_order_seq_cst);
+		if (header->numSleepers.load(std::memory_order_seq_cst) > 0)
+			details::FutexWakeAll(&header->futexWord);
+	}
+
+	template<typename... Args>
+	template<typename... Ts>
+	Connection SharedMemorySignal<void(Args...)>::Connect(Ts&&... ts) {
+		std::lock_guard<std::mutex> lock(mutex);
+		return signal.Connect(std::forward<Ts>(ts)...);
+	}
+
+	template<typename... Args>
+	template<auto slot, typename... Ts>
+	Connection SharedMemorySignal<void(Args...)>::Connect(Ts&&... ts) {
+		std::lock_guard<std::mutex> lock(mutex);
+		return signal.template Connect<slot>(std::forward<Ts>(ts)...);
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::Disconnect(const Connection& connection) {
+		std::lock_guard<std::mutex> lock(mutex);
+		signal.Disconnect(connection);
+	}
+
+	template<typename... Args>
+	template<typename T>
+	void SharedMemorySignal<void(Args...)>::Disconnect(const T* ptr) {
+		std::lock_guard<std::mutex> lock(mutex);
+		signal.Disconnect(ptr);
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::Dispatch(const std::byte* payload) {
+		// the braced initializers are evaluated in order
+		std::tuple<std::remove_cvref_t<Args>...> args{ details::ReadTrivial<std::remove_cvref_t<Args>>(payload)... };
+		std::apply([this](auto&... elems) {
+			signal.Emit(details::PassSlotArg<Args>(elems)...);
+		}, args);
+	}
+
+	template<typename... Args>
+	std::size_t SharedMemorySignal<void(Args...)>::Poll() {
+		assert(IsOpen());
+		std::lock_guard<std::mutex> lock(mutex);
+		std::size_t n = 0;
+		std::array<std::byte, PayloadSize> payload;
+		for (;;) {
+			Entry& entry = GetEntry(readPosition);
+			const std::uint64_t expected = 2 * readPosition + 2;
+			const std::uint64_t sequence = entry.sequence.load(std::memory_order_acquire);
+			if (sequence < expected)
+				break; // not published yet
+
+			if (sequence == expected) {
+				std::memcpy(payload.data(), entry.payload.data(), PayloadSize);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (entry.sequence.load(std::memory_order_relaxed) == expected) {
+					readPosition++;
+					Dispatch(payload.data());
+					n++;
+					continue;
+				}
+			}
+
+			// overwritten by a later lap, skip to the oldest emission in the ring buffer
+			const std::uint64_t writePosition = header->writePosition.load(std::memory_order_acquire);
+			const std::uint64_t oldest = std::max(readPosition + 1,
+				writePosition > header->capacity ? writePosition - header->capacity : 0);
+			numDropped.fetch_add(oldest - readPosition, std::memory_order_relaxed);
+			readPosition = oldest;
+		}
+		return n;
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::ReaderLoop() {
+		while (running.load(std::memory_order_acquire)) {
+			if (Poll() > 0)
+				continue;
+
+			// a short spin avoids a futex wake per emission when the publisher emits in bursts
+			// on a single core the spin only delays the publisher
+			static const std::size_t numSpins = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+			bool published = false;
+			for (std::size_t i = 0; i < numSpins && !published; i++) {
+				std::this_thread::yield();
+				published = GetEntry(readPosition).sequence.load(std::memory_order_acquire) >= 2 * readPosition + 2;
+			}
+			if (published)
+				continue;
+
+			header->numSleepers.fetch_add(1, std::memory_order_seq_cst);
+			const std::uint32_t word = header->futexWord.load(std::memory_order_seq_cst);
+			// an emission between the Poll and the load changed the word, so the futex doesn't sleep
+			published = GetEntry(readPosition).sequence.load(std::memory_order_acquire) >= 2 * readPosition + 2;
+			if (!published && running.load(std::memory_order_acquire))
+				details::FutexWait(&header->futexWord, word, std::chrono::milliseconds(100));
+			header->numSleepers.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::Start() {
+		assert(IsOpen());
+		assert(!reader.joinable());
+		running.store(true, std::memory_order_release);
+		reader = std::thread([this]() { ReaderLoop(); });
+	}
+
+	template<typename... Args>
+	void SharedMemorySignal<void(Args...)>::Stop() {
+		if (!reader.joinable())
+			return;
+		running.store(false, std::memory_order_release);
+		header->futexWord.fetch_add(1, std::memory_order_seq_cst);
+		details::FutexWakeAll(&header->futexWord);
+		reader.join();
+	}
+}
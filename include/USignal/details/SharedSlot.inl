@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename Ret, typename... Args>
+	template<typename Slot>
+	SharedSlot<Ret(Args...)>::SharedSlot(Slot&& slot) :
+		block{ std::make_shared<Block>() }
+	{
+		block->func = unique_function<Ret(Args...)>(std::forward<Slot>(slot));
+		assert(block->func);
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename SignalFunc>
+	Connection SharedSlot<Ret(Args...)>::ConnectTo(Signal<SignalFunc>& signal) {
+		assert(block);
+		const std::size_t id = block->nextID++;
+		Connection connection = signal.Connect(Binding{ block, id });
+		block->entries.push_back(Entry{
+			id,
+			details::SignalAnchorRef{ signal.GetAnchor() },
+			connection,
+			[](details::SignalAnchorHandle* signal, const Connection& connection) {
+				static_cast<Signal<SignalFunc>*>(signal)->Disconnect(connection);
+			}
+		});
+		return connection;
+	}
+
+	template<typename Ret, typename... Args>
+	void SharedSlot<Ret(Args...)>::DisconnectAll() {
+		if (!block)
+			return;
+		// the bindings unregister themselves while disconnecting, so we take the entries out first
+		small_vector<Entry> entries = std::move(block->entries);
+		block->entries.clear();
+		for (const auto& entry : entries) {
+			if (auto* signal = entry.anchor.Get())
+				entry.disconnect(signal, entry.connection);
+		}
+	}
+
+	template<typename Ret, typename... Args>
+	SharedSlot<Ret(Args...)>::Binding::~Binding() {
+		if (!block)
+			return;
+		auto& entries = block->entries;
+		auto target = std::find_if(entries.begin(), entries.end(), [this](const Entry& entry) {
+			return entry.id == id;
+		});
+		if (target != entries.end())
+			entries.erase(target);
+	}
+
+	template<typename Ret, typename... Args>
+	Ret SharedSlot<Ret(Args...)>::Binding::operator()(Args... args) const {
+		if constexpr (std::is_void_v<Ret>)
+			block->func(std::forward<Args>(args)...);
+		else
+			return block->func(std::forward<Args>(args)...);
+	}
+}
@@ -7,10 +7,14 @@ namespace Ubpa::details {
 	// to Ret(void*, Args...)
 	template<typename Ret, typename... Args>
 	struct SlotExpand<Ret(Args...)> {
+		// the result is a plain function pointer Ret(*)(void*, Args...) to an invoker which calls func as a constant,
+		// so the slots of the same signature share one unique_function instantiation,
+		// and the slot stores a single pointer (a member function pointer isn't stored)
 		template<auto func>
 		static auto get() noexcept {
-			constexpr std::size_t N = Length_v<typename FuncTraits<decltype(func)>::ArgList>;
-			return get<func>(std::make_index_sequence<N>{});
+			return static_cast<Ret(*)(void*, Args...)>([](void* obj, Args... args) -> Ret {
+				return get(func)(obj, std::forward<Args>(args)...);
+			});
 		}
 
 		// Ret(Object::*)(...)
@@ -18,15 +22,9 @@ namespace Ubpa::details {
 		// Ret([const] Object*, ...)
 		template<auto memfunc>
 		static auto mem_get() noexcept {
-			using MemFunc = decltype(memfunc);
-			if constexpr (std::is_member_function_pointer_v<std::remove_cvref_t<MemFunc>>) {
-				constexpr std::size_t N = Length_v<typename FuncTraits<MemFunc>::ArgList>;
-				return rmem_get<memfunc>(std::make_index_sequence<N>{});
-			}
-			else {
-				constexpr std::size_t N = Length_v<typename FuncTraits<MemFunc>::ArgList>;
-				return pmem_get<memfunc>(std::make_index_sequence<N - 1>{});
-			}
+			return static_cast<Ret(*)(void*, Args...)>([](void* obj, Args... args) -> Ret {
+				return mem_get(memfunc)(obj, std::forward<Args>(args)...);
+			});
 		}
 
 		template<typename Func>
@@ -51,22 +49,6 @@ namespace Ubpa::details {
 		}
 
 	private:
-		template<auto func, std::size_t... Ns>
-		static auto get(std::index_sequence<Ns...>) {
-			using Func = decltype(func);
-			using FromArgList = typename FuncTraits<Func>::ArgList;
-			using ToArgList = TypeList<Args...>;
-			return [](void*, Args... args) mutable -> Ret {
-				auto argsT = std::forward_as_tuple(std::forward<Args>(args)...);
-				static_assert(details::CheckCompatibleArguments<ToArgList, FromArgList>::value,
-					"from and to arguments are not compatible.");
-				if constexpr (std::is_void_v<Ret>)
-					func(std::get<Ns>(argsT)...);
-				else
-					return func(std::get<Ns>(argsT)...);
-			};
-		}
-
 		template<typename Func, std::size_t... Ns>
 		static auto get(Func&& func, std::index_sequence<Ns...>) {
 			using FromArgList = typename FuncTraits<Func>::ArgList;
@@ -82,55 +64,6 @@ namespace Ubpa::details {
 			};
 		}
 
-		template<auto func, std::size_t... Ns>
-		static auto rmem_get(std::index_sequence<Ns...>) {
-			using Func = decltype(func);
-			using FromArgList = typename FuncTraits<Func>::ArgList;
-			using Object = typename FuncTraits<Func>::Object;
-			using ToArgList = TypeList<Args...>;
-			return [](void* obj, Args... args) mutable -> Ret {
-				auto argsT = std::forward_as_tuple(std::forward<Args>(args)...);
-				static_assert(details::CheckCompatibleArguments<ToArgList, FromArgList>::value,
-					"from and to arguments are not compatible.");
-				if constexpr (std::is_void_v<Ret>)
-					(reinterpret_cast<Object*>(obj)->*func)(std::get<Ns>(argsT)...);
-				else
-					return (reinterpret_cast<Object*>(obj)->*func)(std::get<Ns>(argsT)...);
-			};
-		}
-
-		template<auto func, std::size_t... Ns>
-		static auto pmem_get(std::index_sequence<Ns...>) {
-			using Func = decltype(func);
-			using FromArgList = typename FuncTraits<Func>::ArgList;
-			using Object = Front_t<FromArgList>;
-			using FromTailArgList = PopFront_t<typename FuncTraits<Func>::ArgList>;
-			using ToArgList = TypeList<Args...>;
-			return [](void* obj, Args... args) mutable -> Ret {
-				auto argsT = std::forward_as_tuple(std::forward<Args>(args)...);
-				static_assert(details::CheckCompatibleArguments<ToArgList, FromTailArgList>::value,
-					"from and to arguments are not compatible.");
-				if constexpr (std::is_void_v<Ret>) {
-					if constexpr (std::is_reference_v<Object>)
-						func(*reinterpret_cast<std::add_pointer_t<Object>>(obj), std::get<Ns>(argsT)...);
-					else if constexpr (std::is_pointer_v<Object>)
-						func(reinterpret_cast<Object>(obj), std::get<Ns>(argsT)...);
-					else
-						static_assert(always_false<Func>);
-				}
-				else {
-					if constexpr (std::is_reference_v<Object>)
-						return func(*reinterpret_cast<std::add_pointer_t<Object>>(obj), std::get<Ns>(argsT)...);
-					else if constexpr (std::is_pointer_v<Object>)
-						return func(reinterpret_cast<Object>(obj), std::get<Ns>(argsT)...);
-					else {
-						static_assert(always_false<Func>);
-						return Ret();
-					}
-				}
-			};
-		}
-
 		template<typename Func, std::size_t... Ns>
 		static auto rmem_get(Func&& func, std::index_sequence<Ns...>) {
 			using FromArgList = typename FuncTraits<Func>::ArgList;
@@ -179,21 +112,168 @@ namespace Ubpa::details {
 			};
 		}
 	};
+
+	// the object type T of a batch function void(std::span<T*>, ...)
+	template<typename Span>
+	struct BatchObject;
+	template<typename T, std::size_t Extent>
+	struct BatchObject<std::span<T*, Extent>> { using type = T; };
+
+	// the instance of the connection to (memslot, obj)
+	// memslot
+	// 1. member function pointer
+	// 2. function pointer or callable object, the first argument is treated as the object, it can be a pointer or reference
+	// if T is const, the object type in memslot must also be const
+	template<typename MemSlot, typename T>
+	void* MemSlotInstance(T* obj) noexcept {
+		if constexpr (std::is_member_function_pointer_v<MemSlot>) {
+			static_assert(!std::is_const_v<T> || FuncTraits_is_const<MemSlot>);
+			return static_cast<member_pointer_traits_object<MemSlot>*>(const_cast<std::remove_const_t<T>*>(obj));
+		}
+		else {
+			using ArgList = FuncTraits_ArgList<MemSlot>;
+			using Object = Front_t<ArgList>;
+			using UnrefObject = std::remove_reference_t<std::remove_pointer_t<Object>>;
+			static_assert(!std::is_const_v<T> || std::is_const_v<UnrefObject>);
+			return static_cast<std::remove_const_t<UnrefObject>*>(const_cast<std::remove_const_t<T>*>(obj));
+		}
+	}
+}
+
+namespace Ubpa::details {
+	// the factories of the copyable slots of a signal type, keyed by (funcptr, is member slot)
+	template<typename Factory>
+	class SlotFactoryRegistry {
+	public:
+		static SlotFactoryRegistry& Instance() {
+			static SlotFactoryRegistry instance;
+			return instance;
+		}
+
+		void Register(const FuncPtr& funcptr, bool member, Factory factory) {
+			std::lock_guard<SpinMutex> lock(mutex);
+			factories.emplace(std::pair{ funcptr, member }, factory);
+		}
+
+		Factory Find(const FuncPtr& funcptr, bool member) const {
+			std::lock_guard<SpinMutex> lock(mutex);
+			auto target = factories.find(std::pair{ funcptr, member });
+			return target != factories.end() ? target->second : nullptr;
+		}
+
+	private:
+		mutable SpinMutex mutex;
+		small_flat_map<std::pair<FuncPtr, bool>, Factory> factories;
+	};
+
+	// we assume unique_function stores a small nothrow movable callable object in itself,
+	// other callable objects are boxed by CountedSlot
+	template<typename F, typename FuncSig>
+	constexpr bool IsHeapSlot_v = sizeof(F) > sizeof(unique_function<FuncSig>) - sizeof(void*)
+		|| !std::is_nothrow_move_constructible_v<F>;
+
+	// a slot boxed on the heap, it adds its bytes to the anchor of the signal while it is alive
+	template<typename F, typename FuncSig>
+	class CountedSlot {
+	public:
+		CountedSlot(F&& func, SignalAnchor* anchor) : func{ std::make_unique<F>(std::move(func)) }, anchor{ anchor }
+		{ anchor->heapSlotBytes += Bytes(); }
+
+		CountedSlot(CountedSlot&& other) noexcept : func{ std::move(other.func) }, anchor{ other.anchor }
+		{ other.anchor = nullptr; }
+
+		~CountedSlot() {
+			if (anchor)
+				anchor->heapSlotBytes -= Bytes();
+		}
+
+		template<typename... Ts>
+		decltype(auto) operator()(Ts&&... args) { return (*func)(std::forward<Ts>(args)...); }
+
+	private:
+		// the box, and the slot itself if unique_function can't store it
+		static constexpr std::size_t Bytes() noexcept
+		{ return sizeof(F) + (IsHeapSlot_v<CountedSlot, FuncSig> ? sizeof(CountedSlot) : 0); }
+
+		std::unique_ptr<F> func;
+		SignalAnchor* anchor;
+	};
 }
 
 namespace Ubpa {
+	template<typename Ret, typename... Args>
+	Signal<Ret(Args...)>& Signal<Ret(Args...)>::operator=(Signal&& rhs) noexcept {
+		if (this == &rhs)
+			return *this;
+		// the old slots are destroyed before the anchor (their counter) and batches (their instances)
+		slots.clear();
+		pending.clear();
+		pendingKeys.clear();
+		batches.clear();
+		details::SignalAnchorHandle::operator=(std::move(rhs));
+		innerID = rhs.innerID;
+		isEmitting = rhs.isEmitting;
+		isStopped = rhs.isStopped;
+		lazyConnect = rhs.lazyConnect;
+		slots = std::move(rhs.slots);
+		pending = std::move(rhs.pending);
+		pendingKeys = std::move(rhs.pendingKeys);
+		batches = std::move(rhs.batches);
+		return *this;
+	}
+
 	template<typename Ret, typename... Args>
 	template<typename Slot>
 	void Signal<Ret(Args...)>::ConnectImpl(const Connection& connection, Slot&& slot) {
-		if constexpr (std::is_constructible_v<unique_function<FuncSig>, Slot>) {
-			unique_function<FuncSig> func(std::forward<Slot>(slot));
-			assert(func);
-			slots.emplace(connection, std::move(func));
-		}
+		if constexpr (std::is_constructible_v<unique_function<FuncSig>, Slot>)
+			InsertSlot(connection, WrapSlot(std::forward<Slot>(slot)));
 		else
 			ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template get(std::forward<Slot>(slot)));
 	}
 
+	template<typename Ret, typename... Args>
+	template<typename Slot>
+	auto Signal<Ret(Args...)>::WrapSlot(Slot&& slot) -> unique_function<FuncSig> {
+		if constexpr (details::IsHeapSlot_v<std::decay_t<Slot>, FuncSig>) {
+			using Boxed = details::CountedSlot<std::decay_t<Slot>, FuncSig>;
+			return unique_function<FuncSig>(Boxed(std::decay_t<Slot>(std::forward<Slot>(slot)), GetAnchor()));
+		}
+		else
+			return unique_function<FuncSig>(std::forward<Slot>(slot));
+	}
+
+	template<typename Ret, typename... Args>
+	template<auto slot, bool member>
+	auto Signal<Ret(Args...)>::MakeSlot(Signal& target) -> unique_function<FuncSig> {
+		if constexpr (member)
+			return target.WrapSlot(details::SlotExpand<Ret(Args...)>::template mem_get<slot>());
+		else
+			return target.WrapSlot(details::SlotExpand<Ret(Args...)>::template get<slot>());
+	}
+
+	template<typename Ret, typename... Args>
+	template<auto slot, bool member>
+	void Signal<Ret(Args...)>::RegisterSlotFactory() {
+		// once per slot
+		static const bool registered = [] {
+			details::SlotFactoryRegistry<SlotFactory>::Instance().Register(slot, member, &MakeSlot<slot, member>);
+			return true;
+		}();
+		(void)registered;
+	}
+
+	template<typename Ret, typename... Args>
+	void Signal<Ret(Args...)>::InsertSlot(const Connection& connection, unique_function<FuncSig>&& func) {
+		assert(func);
+		if (lazyConnect) {
+			// as in eager mode, connecting an existing connection again keeps its slot
+			if (slots.find(connection) == slots.end() && pendingKeys.insert(connection).second)
+				pending.emplace_back(connection, std::move(func));
+		}
+		else
+			slots.emplace(connection, std::move(func));
+	}
+
 	template<typename Ret, typename... Args>
 	template<typename Slot>
 	Connection Signal<Ret(Args...)>::Connect(Slot&& slot) {
@@ -207,9 +287,11 @@ namespace Ubpa {
 	template<typename CallableObject>
 	Connection Signal<Ret(Args...)>::Connect(CallableObject* ptr) {
 		assert(ptr);
-		if constexpr (std::is_function_v<CallableObject>)
-			return Connect(Connection{ nullptr, reinterpret_cast<std::size_t>(ptr) },
-				details::SlotExpand<Ret(Args...)>::template get(ptr));
+		if constexpr (std::is_function_v<CallableObject>) {
+			Connection connection{ nullptr, ptr };
+			ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template get(ptr));
+			return connection;
+		}
 		else
 			return Connect<&CallableObject::operator()>(ptr);
 	}
@@ -218,8 +300,9 @@ namespace Ubpa {
 	template<auto funcptr>
 	Connection Signal<Ret(Args...)>::Connect() {
 		static_assert(std::is_function_v<std::remove_pointer_t<decltype(funcptr)>>);
-		Connection connection{ nullptr, reinterpret_cast<std::size_t>(funcptr) };
-		ConnectImpl(connection, details::SlotExpand<Args>::template get<funcptr>());
+		Connection connection{ nullptr, funcptr };
+		ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template get<funcptr>());
+		RegisterSlotFactory<funcptr, false>();
 		return connection;
 	}
 
@@ -229,25 +312,14 @@ namespace Ubpa {
 		static_assert(memslot != nullptr);
 
 		using MemSlot = decltype(memslot);
+		static_assert(std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>);
 		assert(obj);
-		
-		void* instance;
-		if constexpr (std::is_member_function_pointer_v<MemSlot>) {
-			static_assert(!std::is_const_v<T> || FuncTraits_is_const<MemSlot>);
-			instance = static_cast<member_pointer_traits_object<MemSlot>*>(const_cast<std::remove_const_t<T>*>(obj));
-		}
-		else {
-			static_assert(is_function_pointer_v<decltype(memslot)>);
-			using ArgList = FuncTraits_ArgList<MemSlot>;
-			using Object = Front_t<ArgList>;
-			using UnrefObject = std::remove_reference_t<std::remove_pointer_t<Object>>;
-			static_assert(!std::is_const_v<T> || std::is_const_v<UnrefObject>);
-			instance = static_cast<std::remove_const_t<UnrefObject>*>(const_cast<std::remove_const_t<T>*>(obj));
-		}
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
 		assert(instance);
 
 		Connection connection{ instance, memslot };
 		ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template mem_get<memslot>());
+		RegisterSlotFactory<memslot, true>();
 		return connection;
 	}
 
@@ -255,35 +327,49 @@ namespace Ubpa {
 	template<typename MemSlot, typename T>
 	Connection Signal<Ret(Args...)>::Connect(MemSlot&& memslot, T* obj) {
 		assert(obj);
+		void* instance = details::MemSlotInstance<MemSlot>(obj);
+		assert(instance);
 
-		void* instance;
 		details::FuncPtr funcptr;
-		if constexpr (std::is_member_function_pointer_v<MemSlot>) {
-			static_assert(!std::is_const_v<T> || FuncTraits_is_const<MemSlot>);
+		if constexpr (std::is_member_function_pointer_v<MemSlot> || is_function_pointer_v<MemSlot>) {
 			assert(memslot);
-			instance = static_cast<member_pointer_traits_object<MemSlot>*>(const_cast<std::remove_const_t<T>*>(obj));
 			funcptr = memslot;
 		}
-		else {
-			using ArgList = FuncTraits_ArgList<MemSlot>;
-			using Object = Front_t<ArgList>;
-			using UnrefObject = std::remove_reference_t<std::remove_pointer_t<Object>>;
-			static_assert(!std::is_const_v<T> || std::is_const_v<UnrefObject>);
-			instance = static_cast<std::remove_const_t<UnrefObject>*>(const_cast<std::remove_const_t<T>*>(obj));
-			if constexpr (is_function_pointer_v<MemSlot>) {
-				assert(memslot);
-				funcptr = memslot;
-			}
-			else
-				funcptr = reinterpret_cast<FuncSig*>(innerID++);
-		}
-		assert(instance);
+		else
+			funcptr = reinterpret_cast<FuncSig*>(innerID++);
 
 		Connection connection{ instance, funcptr };
 		ConnectImpl(connection, details::SlotExpand<Ret(Args...)>::template mem_get(std::forward<MemSlot>(memslot)));
 		return connection;
 	}
 
+	template<typename Ret, typename... Args>
+	template<auto batchfunc, typename T> requires std::is_void_v<Ret>
+	Connection Signal<Ret(Args...)>::ConnectBatch(T* obj) {
+		using BatchFunc = decltype(batchfunc);
+		static_assert(is_function_pointer_v<BatchFunc>);
+		using Object = typename details::BatchObject<std::remove_cvref_t<Front_t<FuncTraits_ArgList<BatchFunc>>>>::type;
+		static_assert(!std::is_const_v<T> || std::is_const_v<Object>);
+		assert(obj);
+		void* instance = static_cast<std::remove_const_t<Object>*>(const_cast<std::remove_const_t<T>*>(obj));
+
+		std::vector<void*>* instances = FindBatch(batchfunc);
+		if (!instances) {
+			auto& batch = batches.emplace_back(batchfunc, std::make_unique<std::vector<void*>>());
+			instances = batch.second.get();
+			InsertSlot(Connection{ nullptr, batchfunc }, unique_function<FuncSig>([instances](void*, Args... args) {
+				if (instances->empty())
+					return;
+				batchfunc(std::span<Object*>(reinterpret_cast<Object**>(instances->data()), instances->size()),
+					std::forward<Args>(args)...);
+			}));
+		}
+		const auto target = std::lower_bound(instances->begin(), instances->end(), instance, std::less<>{});
+		if (target == instances->end() || *target != instance)
+			instances->insert(target, instance);
+		return { instance, batchfunc };
+	}
+
 	template<typename Ret, typename... Args>
 	template<typename Slot>
 	ScopedConnection<Ret(Args...)> Signal<Ret(Args...)>::ScopeConnect(Slot&& slot)
@@ -309,14 +395,45 @@ namespace Ubpa {
 	ScopedConnection<Ret(Args...)> Signal<Ret(Args...)>::ScopeConnect(MemSlot&& memslot, T* obj)
 	{ return { Connect(std::forward<MemSlot>(memslot), obj), this }; }
 
+	template<typename Ret, typename... Args>
+	template<auto batchfunc, typename T> requires std::is_void_v<Ret>
+	ScopedConnection<Ret(Args...)> Signal<Ret(Args...)>::ScopeConnectBatch(T* obj)
+	{ return { ConnectBatch<batchfunc>(obj), this }; }
+
+	template<typename Ret, typename... Args>
+	template<typename... Ts>
+	TrackedConnection<Ret(Args...)> Signal<Ret(Args...)>::ScopeConnectTracked(Ts&&... ts)
+	{ return { Connect(std::forward<Ts>(ts)...), GetAnchor() }; }
+
+	template<typename Ret, typename... Args>
+	template<auto slot, typename... Ts>
+	TrackedConnection<Ret(Args...)> Signal<Ret(Args...)>::ScopeConnectTracked(Ts&&... ts)
+	{ return { Connect<slot>(std::forward<Ts>(ts)...), GetAnchor() }; }
+
+	template<typename Ret, typename... Args>
+	template<typename Visitor>
+	void Signal<Ret(Args...)>::Visit(Visitor&& visitor) {
+		for (auto& [c, slot] : slots) {
+			assert(slot);
+			if (visitor(c, slot))
+				return;
+		}
+		for (auto& [c, slot] : pending) {
+			assert(slot);
+			if (visitor(c, slot))
+				return;
+		}
+	}
+
 	template<typename Ret, typename... Args>
 	void Signal<Ret(Args...)>::Emit(Args... args) {
 		assert(!isEmitting);
 		isEmitting = true;
-		for (auto& [c, slot] : slots) {
-			assert(slot);
+		isStopped = false;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
 			slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...);
-		}
+			return false;
+		});
 		isEmitting = false;
 	}
 
@@ -325,17 +442,202 @@ namespace Ubpa {
 	void Signal<Ret(Args...)>::Emit(Acc&& acc, Args... args) {
 		assert(!isEmitting);
 		isEmitting = true;
-		for (auto& [c, slot] : slots) {
-			assert(slot);
+		isStopped = false;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
 			acc(slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...));
+			return false;
+		});
+		isEmitting = false;
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename R> requires std::negation_v<std::is_void<R>>
+	std::size_t Signal<Ret(Args...)>::EmitCollect(std::span<std::type_identity_t<R>> out, Args... args) {
+		assert(!isEmitting);
+		if (out.empty())
+			return 0;
+		isEmitting = true;
+		isStopped = false;
+		std::size_t n = 0;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
+			out[n++] = slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...);
+			return n == out.size();
+		});
+		isEmitting = false;
+		return n;
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename R> requires std::negation_v<std::is_void<R>>
+	std::size_t Signal<Ret(Args...)>::EmitCollect(std::vector<std::type_identity_t<R>>& out, Args... args) {
+		assert(!isEmitting);
+		isEmitting = true;
+		isStopped = false;
+		out.clear();
+		out.reserve(Size());
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
+			out.push_back(slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...));
+			return false;
+		});
+		isEmitting = false;
+		return out.size();
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename Pred> requires std::negation_v<std::is_void<Ret>>
+	std::optional<Connection> Signal<Ret(Args...)>::EmitUntil(Pred&& pred, Args... args) {
+		assert(!isEmitting);
+		isEmitting = true;
+		isStopped = false;
+		std::optional<Connection> consumer;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
+			if (pred(slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...)) || isStopped) {
+				consumer = c;
+				return true;
+			}
+			return false;
+		});
+		isStopped = false;
+		isEmitting = false;
+		return consumer;
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename R> requires std::is_void_v<R>
+	std::optional<Connection> Signal<Ret(Args...)>::EmitUntil(Args... args) {
+		assert(!isEmitting);
+		isEmitting = true;
+		isStopped = false;
+		std::optional<Connection> consumer;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
+			slot(reinterpret_cast<void*>(c.instance), std::forward<Args>(args)...);
+			if (isStopped) {
+				consumer = c;
+				return true;
+			}
+			return false;
+		});
+		isStopped = false;
+		isEmitting = false;
+		return consumer;
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename R> requires std::is_void_v<R>
+	EmissionCursor<Ret(Args...)> Signal<Ret(Args...)>::EmitIncremental(std::chrono::nanoseconds budget, Args... args) {
+		static_assert(((!std::is_lvalue_reference_v<Args> || std::is_const_v<std::remove_reference_t<Args>>) && ...),
+			"the arguments of EmitIncremental must be values, const references or rvalue references");
+		EmissionCursor<Ret(Args...)> cursor{ GetAnchor(), std::forward<Args>(args)... };
+		cursor.Resume(budget);
+		return cursor;
+	}
+
+	template<typename Ret, typename... Args>
+	bool Signal<Ret(Args...)>::ResumeEmission(EmissionCursor<Ret(Args...)>& cursor, std::chrono::steady_clock::time_point deadline) {
+		assert(!isEmitting);
+		// the cursor is a key, so the slots connected and disconnected since the last resumption are handled by the table
+		MergePending();
+		auto iter = slots.begin();
+		if (cursor.last) {
+			iter = slots.lower_bound(*cursor.last);
+			if (iter != slots.end() && iter->first == *cursor.last)
+				++iter;
 		}
+		isEmitting = true;
+		isStopped = false;
+		std::apply([&](auto&... elems) {
+			while (iter != slots.end()) {
+				const Connection& c = iter->first;
+				iter->second(reinterpret_cast<void*>(c.instance), details::PassSlotArg<Args>(elems)...);
+				cursor.last = c;
+				cursor.numCalled++;
+				++iter;
+				if (isStopped) {
+					iter = slots.end();
+					break;
+				}
+				if (std::chrono::steady_clock::now() >= deadline)
+					break;
+			}
+		}, *cursor.args);
+		isStopped = false;
 		isEmitting = false;
+		return iter == slots.end();
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename Factory>
+	bool Signal<Ret(Args...)>::EmitLazy(Factory&& factory)
+	{ return EmitLazy([](const Connection&) { return true; }, std::forward<Factory>(factory)); }
+
+	template<typename Ret, typename... Args>
+	template<typename Filter, typename Factory>
+	bool Signal<Ret(Args...)>::EmitLazy(Filter&& filter, Factory&& factory) {
+		assert(!isEmitting);
+		if (Empty())
+			return false;
+
+		using Result = std::invoke_result_t<Factory&>;
+		// the result is built in place, it is not moved
+		struct Holder {
+			Holder(Factory& factory) : value{ factory() } {}
+			Result value;
+		};
+		constexpr bool isTuple = details::IsTuple<std::remove_cvref_t<Result>>::value
+			&& !(sizeof...(Args) == 1 && std::is_same_v<std::remove_cvref_t<Result>, std::remove_cvref_t<Front_t<TypeList<Args...>>>>);
+		static_assert(isTuple || sizeof...(Args) == 1, "factory should return a std::tuple of the arguments");
+
+		isEmitting = true;
+		isStopped = false;
+		std::optional<Holder> args;
+		Visit([&](const Connection& c, unique_function<FuncSig>& slot) {
+			if (!filter(c))
+				return false;
+			if (!args)
+				args.emplace(factory);
+			if constexpr (isTuple) {
+				std::apply([&](auto&... elems) {
+					slot(reinterpret_cast<void*>(c.instance), details::PassSlotArg<Args>(elems)...);
+				}, args->value);
+			}
+			else
+				slot(reinterpret_cast<void*>(c.instance), details::PassSlotArg<Args>(args->value)...);
+			return false;
+		});
+		isEmitting = false;
+		return args.has_value();
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename... Ts>
+	bool Signal<Ret(Args...)>::InvokeSlot(const Connection& connection, Ts&&... args) {
+		unique_function<FuncSig>* slot = nullptr;
+		if (pendingKeys.find(connection) != pendingKeys.end()) {
+			// the slot is usually the one just connected, so pending is searched from the back
+			auto pendingTarget = std::find_if(pending.rbegin(), pending.rend(), [&](const auto& p) { return p.first == connection; });
+			assert(pendingTarget != pending.rend());
+			slot = &pendingTarget->second;
+		}
+		else if (auto target = slots.find(connection); target != slots.end())
+			slot = &target->second;
+		else
+			return false;
+		assert(*slot);
+		(*slot)(connection.instance, std::forward<Ts>(args)...);
+		return true;
 	}
 
 	template<typename Ret, typename... Args>
 	void Signal<Ret(Args...)>::Disconnect(const Connection& connection) {
 		assert(!isEmitting);
-		slots.erase(connection);
+		MergePending();
+		if (slots.erase(connection) == 0)
+			DisconnectBatch(connection);
+		else if (connection.instance == nullptr) {
+			// the slot of a batch, all its instances are disconnected
+			if (const auto batch = FindBatchIter(connection.funcptr); batch != batches.end())
+				batches.erase(batch);
+		}
 	}
 
 	template<typename Ret, typename... Args>
@@ -344,12 +646,17 @@ namespace Ubpa {
 		if constexpr (std::is_function_v<T>)
 			Disconnect(Connection{ nullptr, ptr });
 		else{
+			assert(!isEmitting);
+			MergePending();
 			const auto iter_begin = slots.lower_bound(ptr);
 			const auto iter_end = slots.end();
 			auto cursor = iter_begin;
 			while (cursor != iter_end && cursor->first.instance == ptr)
 				++cursor;
 			slots.erase(iter_begin, cursor);
+			// DisconnectBatch may remove the batch
+			for (std::size_t i = batches.size(); i-- > 0;)
+				DisconnectBatch(Connection{ const_cast<T*>(ptr), batches[i].first });
 		}
 	}
 
@@ -376,12 +683,16 @@ namespace Ubpa {
 	void Signal<Ret(Args...)>::Clear() noexcept {
 		assert(!isEmitting);
 		slots.clear();
+		pending.clear();
+		pendingKeys.clear();
+		batches.clear();
 	}
 
 	template<typename Ret, typename... Args>
 	template<typename T>
 	void Signal<Ret(Args...)>::MoveInstance(T* dst, const T* src) {
 		assert(!isEmitting);
+		MergePending();
 		const auto iter_begin = slots.lower_bound(src);
 		const auto iter_end = slots.end();
 		auto cursor = iter_begin;
@@ -392,5 +703,210 @@ namespace Ubpa {
 		}
 		slots.erase(iter_begin, cursor);
 		slots.insert(std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+
+		for (auto& [batchfunc, instances] : batches) {
+			const void* instance = src;
+			const auto target = std::lower_bound(instances->begin(), instances->end(), instance, std::less<>{});
+			if (target == instances->end() || *target != instance)
+				continue;
+			instances->erase(target);
+			void* dstInstance = dst;
+			instances->insert(std::lower_bound(instances->begin(), instances->end(), dstInstance, std::less<>{}), dstInstance);
+		}
+	}
+
+	template<typename Ret, typename... Args>
+	void Signal<Ret(Args...)>::RelocateRange(const void* srcBegin, const void* srcEnd, void* dstBegin, std::size_t stride) {
+		assert(!isEmitting);
+		assert(stride > 0);
+		assert((static_cast<const std::byte*>(srcEnd) - static_cast<const std::byte*>(srcBegin)) % stride == 0);
+		MergePending();
+		const auto rebase = [&](const void* instance) -> void* {
+			return static_cast<std::byte*>(dstBegin) + (static_cast<const std::byte*>(instance) - static_cast<const std::byte*>(srcBegin));
+		};
+		// the relocated instances keep their order, so the block is rebased in place and rotated to its new position
+		for (auto& [batchfunc, instances] : batches) {
+			const auto first = std::lower_bound(instances->begin(), instances->end(), srcBegin, std::less<>{});
+			const auto last = std::lower_bound(first, instances->end(), srcEnd, std::less<>{});
+			if (first == last)
+				continue;
+			for (auto cursor = first; cursor != last; ++cursor)
+				*cursor = rebase(*cursor);
+			const void* front = *first;
+			if (std::less<>{}(dstBegin, srcBegin))
+				std::rotate(std::lower_bound(instances->begin(), first, front, std::less<>{}), first, last);
+			else
+				std::rotate(first, last, std::lower_bound(last, instances->end(), front, std::less<>{}));
+		}
+		// connections are sorted by instance, so the range is contiguous
+		const auto iter_begin = slots.lower_bound(srcBegin);
+		const auto iter_end = slots.lower_bound(srcEnd);
+		if (iter_begin == iter_end)
+			return;
+		for (auto cursor = iter_begin; cursor != iter_end; ++cursor)
+			cursor->first.instance = rebase(cursor->first.instance);
+		const Connection front = iter_begin->first;
+		const auto less = [](const auto& lhs, const Connection& rhs) { return lhs.first < rhs; };
+		if (std::less<>{}(dstBegin, srcBegin))
+			std::rotate(std::lower_bound(slots.begin(), iter_begin, front, less), iter_begin, iter_end);
+		else
+			std::rotate(iter_begin, iter_end, std::lower_bound(iter_end, slots.end(), front, less));
+	}
+
+	template<typename Ret, typename... Args>
+	std::size_t Signal<Ret(Args...)>::MemoryUsage() const noexcept {
+		std::size_t usage = sizeof(Signal);
+		// the first InlineSlots slots are stored in the signal
+		if (slots.capacity() > InlineSlots)
+			usage += slots.capacity() * sizeof(typename decltype(slots)::value_type);
+		usage += pending.capacity() * sizeof(typename decltype(pending)::value_type);
+		usage += pendingKeys.bucket_count() * sizeof(void*) + pendingKeys.size() * (sizeof(Connection) + 2 * sizeof(void*));
+		// the anchor is pooled, only the slots it counts are owned by the signal
+		if (const details::SignalAnchor* anchor = PeekAnchor())
+			usage += anchor->heapSlotBytes;
+		usage += batches.capacity() * sizeof(typename decltype(batches)::value_type);
+		for (const auto& [batchfunc, instances] : batches)
+			usage += sizeof(std::vector<void*>) + instances->capacity() * sizeof(void*);
+		return usage;
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename Iter, typename Map>
+	void Signal<Ret(Args...)>::CloneSlots(Iter first, Iter last, Map&& map, Signal& target,
+		std::vector<std::pair<Connection, unique_function<FuncSig>>>& buffer) const
+	{
+		const auto& registry = details::SlotFactoryRegistry<SlotFactory>::Instance();
+		// the connections of an instance are adjacent, the factory of the last one is likely reused
+		std::optional<std::pair<Connection, SlotFactory>> cache;
+		for (auto cursor = first; cursor != last; ++cursor) {
+			const Connection& c = cursor->first;
+			const bool member = c.instance != nullptr;
+			if (!cache || !(cache->first.funcptr == c.funcptr) || (cache->first.instance != nullptr) != member)
+				cache.emplace(c, registry.Find(c.funcptr, member));
+			const auto factory = cache->second;
+			if (!factory)
+				continue;
+			void* instance = member ? map(c.instance) : nullptr;
+			if (member && !instance)
+				continue;
+			buffer.emplace_back(Connection{ instance, c.funcptr }, factory(target));
+		}
+	}
+
+	template<typename Ret, typename... Args>
+	template<typename Map>
+	Signal<Ret(Args...)> Signal<Ret(Args...)>::Clone(Map&& map) const {
+		Signal result;
+		std::vector<std::pair<Connection, unique_function<FuncSig>>> buffer;
+		buffer.reserve(slots.size() + pending.size());
+		CloneSlots(slots.begin(), slots.end(), map, result, buffer);
+		CloneSlots(pending.begin(), pending.end(), map, result, buffer);
+		// map may send several instances to one, the first connection wins
+		std::stable_sort(buffer.begin(), buffer.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first < rhs.first;
+		});
+		buffer.erase(std::unique(buffer.begin(), buffer.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first == rhs.first;
+		}), buffer.end());
+		// the table of result is empty, so the merge only appends the sorted buffer
+		result.MergeSorted(buffer);
+		return result;
+	}
+
+	template<typename Ret, typename... Args>
+	std::size_t Signal<Ret(Args...)>::CloneInstance(const void* src, void* dst) {
+		assert(!isEmitting);
+		assert(src && dst);
+		MergePending();
+		const auto iter_begin = slots.lower_bound(src);
+		auto iter_end = iter_begin;
+		while (iter_end != slots.end() && iter_end->first.instance == src)
+			++iter_end;
+		std::vector<std::pair<Connection, unique_function<FuncSig>>> buffer;
+		// the connections of src are sorted by funcptr, so the buffer is sorted
+		CloneSlots(iter_begin, iter_end, [dst](void*) { return dst; }, *this, buffer);
+		// the existing connections of dst keep their slots
+		return MergeSorted(buffer);
+	}
+
+	template<typename Ret, typename... Args>
+	std::size_t Signal<Ret(Args...)>::Size() const noexcept {
+		// a batch is one slot in the table
+		std::size_t size = slots.size() + pending.size() - batches.size();
+		for (const auto& [batchfunc, instances] : batches)
+			size += instances->size();
+		return size;
+	}
+
+	template<typename Ret, typename... Args>
+	std::vector<void*>* Signal<Ret(Args...)>::FindBatch(const details::FuncPtr& batchfunc) noexcept {
+		const auto target = FindBatchIter(batchfunc);
+		return target != batches.end() ? target->second.get() : nullptr;
+	}
+
+	template<typename Ret, typename... Args>
+	auto Signal<Ret(Args...)>::FindBatchIter(const details::FuncPtr& batchfunc) noexcept -> typename std::vector<Batch>::iterator {
+		return std::find_if(batches.begin(), batches.end(), [&](const auto& batch) { return batch.first == batchfunc; });
+	}
+
+	template<typename Ret, typename... Args>
+	bool Signal<Ret(Args...)>::DisconnectBatch(const Connection& connection) {
+		const auto batch = FindBatchIter(connection.funcptr);
+		if (batch == batches.end())
+			return false;
+		std::vector<void*>& instances = *batch->second;
+		const auto target = std::lower_bound(instances.begin(), instances.end(), connection.instance, std::less<>{});
+		if (target == instances.end() || *target != connection.instance)
+			return false;
+		instances.erase(target);
+		if (instances.empty()) {
+			MergePending();
+			slots.erase(Connection{ nullptr, batch->first });
+			batches.erase(batch);
+		}
+		return true;
+	}
+
+	template<typename Ret, typename... Args>
+	void Signal<Ret(Args...)>::SetLazyConnect(bool enable) {
+		assert(!isEmitting);
+		lazyConnect = enable;
+		if (!enable)
+			MergePending();
+	}
+
+	template<typename Ret, typename... Args>
+	void Signal<Ret(Args...)>::MergePending() {
+		if (pending.empty())
+			return;
+		// the appended connections are unique (see InsertSlot)
+		std::sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first < rhs.first;
+		});
+		MergeSorted(pending);
+		pendingKeys.clear();
+	}
+
+	template<typename Ret, typename... Args>
+	std::size_t Signal<Ret(Args...)>::MergeSorted(std::vector<std::pair<Connection, unique_function<FuncSig>>>& run) {
+		// the table keeps its slot for a connection in both
+		run.erase(std::remove_if(run.begin(), run.end(), [this](const auto& elem) {
+			return slots.find(elem.first) != slots.end();
+		}), run.end());
+		if (run.empty())
+			return 0;
+		// the table grows at its end by placeholders (greater than any connection) which take the run,
+		// then the two sorted runs are merged in place
+		const std::size_t size = slots.size();
+		void* const placeholder = reinterpret_cast<void*>(~std::uintptr_t{ 0 });
+		slots.reserve(size + run.size());
+		for (std::size_t i = 0; i < run.size(); i++)
+			slots.emplace_hint(slots.end(), Connection{ placeholder, reinterpret_cast<FuncSig*>(i) }, unique_function<FuncSig>{});
+		const auto middle = std::move(run.begin(), run.end(), slots.begin() + size);
+		std::inplace_merge(slots.begin(), slots.begin() + size, middle, [](const auto& lhs, const auto& rhs) {
+			return lhs.first < rhs.first;
+		});
+		run.clear();
+		return slots.size() - size;
 	}
 }
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "SpinMutex.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ubpa::details {
+	class SignalAnchorHandle;
+
+	// the control block shared by a signal and its tracked connections
+	struct SignalAnchor {
+		union {
+			SignalAnchorHandle* handle; // the signal, nullptr if it is destroyed
+			SignalAnchor* nextFree;
+		};
+		std::uint32_t numRefs;
+		std::size_t heapSlotBytes; // the boxed slots of the signal, see details::CountedSlot
+	};
+
+	// a slab allocator of anchors, it is never destroyed,
+	// so anchors can be released during static destruction
+	class SignalAnchorPool {
+	public:
+		static SignalAnchorPool& Instance() {
+			static SignalAnchorPool* pool = new SignalAnchorPool;
+			return *pool;
+		}
+
+		SignalAnchor* Allocate(SignalAnchorHandle* handle) {
+			std::lock_guard<SpinMutex> lock(mutex);
+			if (!freeList) {
+				auto& slab = slabs.emplace_back(std::make_unique<SignalAnchor[]>(SlabSize));
+				for (std::size_t i = 0; i < SlabSize; i++) {
+					slab[i].nextFree = freeList;
+					freeList = &slab[i];
+				}
+			}
+			SignalAnchor* anchor = freeList;
+			freeList = anchor->nextFree;
+			anchor->handle = handle;
+			anchor->numRefs = 1;
+			anchor->heapSlotBytes = 0;
+			return anchor;
+		}
+
+		void Free(SignalAnchor* anchor) noexcept {
+			std::lock_guard<SpinMutex> lock(mutex);
+			anchor->nextFree = freeList;
+			freeList = anchor;
+		}
+
+	private:
+		static constexpr std::size_t SlabSize = 256;
+
+		SpinMutex mutex;
+		SignalAnchor* freeList{ nullptr };
+		std::vector<std::unique_ptr<SignalAnchor[]>> slabs;
+	};
+
+	inline void AddRef(SignalAnchor* anchor) noexcept { anchor->numRefs++; }
+
+	inline void Unref(SignalAnchor* anchor) noexcept {
+		assert(anchor->numRefs > 0);
+		if (--anchor->numRefs == 0)
+			SignalAnchorPool::Instance().Free(anchor);
+	}
+
+	// a counted reference to an anchor, it keeps the anchor alive (not the signal)
+	class SignalAnchorRef {
+	public:
+		SignalAnchorRef() noexcept = default;
+
+		explicit SignalAnchorRef(SignalAnchor* anchor) noexcept : anchor{ anchor } {
+			if (anchor)
+				AddRef(anchor);
+		}
+
+		SignalAnchorRef(SignalAnchorRef&& other) noexcept : anchor{ other.anchor } { other.anchor = nullptr; }
+
+		SignalAnchorRef& operator=(SignalAnchorRef&& rhs) noexcept {
+			std::swap(anchor, rhs.anchor);
+			return *this;
+		}
+
+		~SignalAnchorRef() {
+			if (anchor)
+				Unref(anchor);
+		}
+
+		// nullptr if the signal is destroyed
+		SignalAnchorHandle* Get() const noexcept { return anchor ? anchor->handle : nullptr; }
+
+	private:
+		SignalAnchor* anchor{ nullptr };
+	};
+
+	// the base of Signal, it keeps the anchor pointing to the signal when the signal is moved,
+	// and marks the anchor dead when the signal is destroyed
+	// the anchor is allocated by the first tracked connection
+	class SignalAnchorHandle {
+	public:
+		SignalAnchorHandle() noexcept = default;
+
+		SignalAnchorHandle(SignalAnchorHandle&& other) noexcept : anchor{ other.anchor } {
+			other.anchor = nullptr;
+			if (anchor)
+				anchor->handle = this;
+		}
+
+		SignalAnchorHandle& operator=(SignalAnchorHandle&& rhs) noexcept {
+			if (this != &rhs) {
+				ReleaseAnchor();
+				anchor = rhs.anchor;
+				rhs.anchor = nullptr;
+				if (anchor)
+					anchor->handle = this;
+			}
+			return *this;
+		}
+
+		~SignalAnchorHandle() { ReleaseAnchor(); }
+
+	protected:
+		SignalAnchor* GetAnchor() {
+			if (!anchor)
+				anchor = SignalAnchorPool::Instance().Allocate(this);
+			return anchor;
+		}
+
+		// nullptr if no anchor is allocated yet
+		const SignalAnchor* PeekAnchor() const noexcept { return anchor; }
+
+		void SwapAnchor(SignalAnchorHandle& other) noexcept {
+			std::swap(anchor, other.anchor);
+			if (anchor)
+				anchor->handle = this;
+			if (other.anchor)
+				other.anchor->handle = &other;
+		}
+
+	private:
+		void ReleaseAnchor() noexcept {
+			if (!anchor)
+				return;
+			anchor->handle = nullptr;
+			Unref(anchor);
+			anchor = nullptr;
+		}
+
+		SignalAnchor* anchor{ nullptr };
+	};
+}
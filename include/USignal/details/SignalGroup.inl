@@ -0,0 +1,75 @@
+#pragma once
+
+namespace Ubpa::details {
+	// calls slot(instance, Params...) with the concatenated arguments of the tuples
+	template<typename Slot, typename... Params, typename... Tuples>
+	void CallSlotWithTuples(Slot& slot, void* instance, TypeList<Params...>, Tuples&... tuples) {
+		auto args = std::tuple_cat(std::apply([](auto&... elems) { return std::tie(elems...); }, tuples)...);
+		static_assert(std::tuple_size_v<decltype(args)> == sizeof...(Params));
+		[&]<std::size_t... Ns>(std::index_sequence<Ns...>) {
+			slot(instance, PassSlotArg<Params>(std::get<Ns>(args))...);
+		}(std::index_sequence_for<Params...>{});
+	}
+}
+
+namespace Ubpa {
+	template<typename... Funcs>
+	template<typename... ArgTuples>
+	void SignalGroup<Funcs...>::Emit(ArgTuples&&... args) {
+		constexpr std::size_t N = sizeof...(Funcs);
+		static_assert(sizeof...(ArgTuples) == N);
+
+		auto tables = std::apply([this](auto&... signals) {
+			return std::tie(signals..., combined);
+		}, signals);
+		auto argTuples = std::forward_as_tuple(args...);
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			auto prepare = [](auto& signal) {
+				assert(!signal.isEmitting);
+				signal.MergePending();
+				signal.isEmitting = true;
+				signal.isStopped = false;
+			};
+			(prepare(std::get<Is>(tables)), ...);
+
+			auto cursors = std::make_tuple(std::get<Is>(tables).slots.begin()...);
+			auto ends = std::make_tuple(std::get<Is>(tables).slots.end()...);
+
+			for (;;) {
+				// the smallest instance of all tables
+				bool found = false;
+				void* instance = nullptr;
+				auto select = [&](auto cursor, auto end) {
+					if (cursor != end && (!found || std::less<void*>{}(cursor->first.instance, instance))) {
+						instance = cursor->first.instance;
+						found = true;
+					}
+				};
+				(select(std::get<Is>(cursors), std::get<Is>(ends)), ...);
+				if (!found)
+					break;
+
+				auto dispatch = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+					auto& cursor = std::get<I>(cursors);
+					while (cursor != std::get<I>(ends) && cursor->first.instance == instance) {
+						assert(cursor->second);
+						if constexpr (I < N) {
+							using Params = typename details::SignalArgList<std::tuple_element_t<I, std::tuple<Funcs...>>>::type;
+							details::CallSlotWithTuples(cursor->second, instance, Params{}, std::get<I>(argTuples));
+						}
+						else {
+							std::apply([&](auto&... all) {
+								details::CallSlotWithTuples(cursor->second, instance,
+									typename details::SignalArgList<CombinedFunc>::type{}, all...);
+							}, argTuples);
+						}
+						++cursor;
+					}
+				};
+				(dispatch(std::integral_constant<std::size_t, Is>{}), ...);
+			}
+
+			((std::get<Is>(tables).isEmitting = false), ...);
+		}(std::make_index_sequence<N + 1>{});
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+namespace Ubpa {
+	inline SignalRegistration::SignalRegistration(SignalRegistration&& other) noexcept :
+		registry{ other.registry }, signal{ other.signal }
+	{
+		other.registry = nullptr;
+		other.signal = nullptr;
+	}
+
+	inline SignalRegistration& SignalRegistration::operator=(SignalRegistration&& rhs) noexcept {
+		if (this != &rhs) {
+			Release();
+			registry = rhs.registry;
+			signal = rhs.signal;
+			rhs.registry = nullptr;
+			rhs.signal = nullptr;
+		}
+		return *this;
+	}
+
+	inline void SignalRegistration::Release() {
+		if (registry) {
+			registry->Unregister(signal);
+			registry = nullptr;
+			signal = nullptr;
+		}
+	}
+
+	template<typename Func>
+	SignalRegistration SignalRegistry::Register(const Signal<Func>* signal, std::string name) {
+		return RegisterImpl(signal, std::move(name));
+	}
+
+	template<typename T, typename Func>
+	SignalRegistration SignalRegistry::Register(const MSignal<T, Func>* signal, std::string name) {
+		return RegisterImpl(signal, std::move(name));
+	}
+
+	template<typename SignalType>
+	SignalRegistration SignalRegistry::RegisterImpl(const SignalType* signal, std::string name) {
+		assert(signal);
+		std::lock_guard<std::mutex> lock(mutex);
+		assert(std::find_if(entries.begin(), entries.end(), [signal](const Entry& entry) {
+			return entry.signal == signal;
+		}) == entries.end());
+		entries.push_back(Entry{
+			signal,
+			std::move(name),
+			[](const void* signal) noexcept { return static_cast<const SignalType*>(signal)->Size(); },
+			[](const void* signal) noexcept { return static_cast<const SignalType*>(signal)->MemoryUsage(); }
+		});
+		return { this, signal };
+	}
+
+	inline void SignalRegistry::Unregister(const void* signal) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto target = std::find_if(entries.begin(), entries.end(), [signal](const Entry& entry) {
+			return entry.signal == signal;
+		});
+		if (target != entries.end()) {
+			*target = std::move(entries.back());
+			entries.pop_back();
+		}
+	}
+
+	inline std::size_t SignalRegistry::NumSignals() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return entries.size();
+	}
+
+	inline std::vector<SignalStats> SignalRegistry::Snapshot() const {
+		std::vector<SignalStats> stats;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stats.reserve(entries.size());
+			for (const auto& entry : entries)
+				stats.push_back(SignalStats{ entry.name, entry.signal, entry.size(entry.signal), entry.memoryUsage(entry.signal) });
+		}
+		std::sort(stats.begin(), stats.end(), [](const SignalStats& lhs, const SignalStats& rhs) {
+			return lhs.memoryUsage > rhs.memoryUsage;
+		});
+		return stats;
+	}
+}
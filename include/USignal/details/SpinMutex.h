@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+namespace Ubpa::details {
+	// a lightweight mutex for short critical sections, it meets the Lockable requirements
+	class SpinMutex {
+	public:
+		void lock() noexcept {
+			for (;;) {
+				if (!locked.exchange(true, std::memory_order_acquire))
+					return;
+				while (locked.load(std::memory_order_relaxed))
+					std::this_thread::yield();
+			}
+		}
+
+		bool try_lock() noexcept {
+			return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+		}
+
+		void unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+	private:
+		std::atomic<bool> locked{ false };
+	};
+}
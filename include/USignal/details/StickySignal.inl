@@ -0,0 +1,82 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename... Args, std::size_t K>
+	template<typename... Ts>
+	Connection StickySignal<void(Args...), K>::ConnectReplay(Ts&&... ts) {
+		Connection connection = Signal<void(Args...)>::Connect(std::forward<Ts>(ts)...);
+		Replay(connection);
+		return connection;
+	}
+
+	template<typename... Args, std::size_t K>
+	template<auto slot, typename... Ts>
+	Connection StickySignal<void(Args...), K>::ConnectReplay(Ts&&... ts) {
+		Connection connection = Signal<void(Args...)>::template Connect<slot>(std::forward<Ts>(ts)...);
+		Replay(connection);
+		return connection;
+	}
+
+	template<typename... Args, std::size_t K>
+	template<typename... Ts>
+	ScopedConnection<void(Args...)> StickySignal<void(Args...), K>::ScopeConnectReplay(Ts&&... ts)
+	{ return { ConnectReplay(std::forward<Ts>(ts)...), this }; }
+
+	template<typename... Args, std::size_t K>
+	template<auto slot, typename... Ts>
+	ScopedConnection<void(Args...)> StickySignal<void(Args...), K>::ScopeConnectReplay(Ts&&... ts)
+	{ return { ConnectReplay<slot>(std::forward<Ts>(ts)...), this }; }
+
+	template<typename... Args, std::size_t K>
+	void StickySignal<void(Args...), K>::Emit(std::type_identity_t<Args>... args) {
+		Values& values = Push(std::forward<Args>(args)...);
+		std::apply([this](const auto&... elems) {
+			Signal<void(Args...)>::Emit(elems...);
+		}, values);
+	}
+
+	template<typename... Args, std::size_t K>
+	void StickySignal<void(Args...), K>::Set(std::type_identity_t<Args>... args)
+	{ Push(std::forward<Args>(args)...); }
+
+	template<typename... Args, std::size_t K>
+	auto StickySignal<void(Args...), K>::Latest() const noexcept -> const Values* {
+		if (numCached == 0)
+			return nullptr;
+		return &*cache[(next + K - 1) % K];
+	}
+
+	template<typename... Args, std::size_t K>
+	auto StickySignal<void(Args...), K>::Cached(std::size_t i) const noexcept -> const Values& {
+		assert(i < numCached);
+		return *cache[(next + K - numCached + i) % K];
+	}
+
+	template<typename... Args, std::size_t K>
+	void StickySignal<void(Args...), K>::ResetCache() noexcept {
+		for (auto& values : cache)
+			values.reset();
+		next = 0;
+		numCached = 0;
+	}
+
+	template<typename... Args, std::size_t K>
+	auto StickySignal<void(Args...), K>::Push(std::type_identity_t<Args>... args) -> Values& {
+		auto& values = cache[next];
+		values.emplace(std::forward<Args>(args)...);
+		next = (next + 1) % K;
+		if (numCached < K)
+			numCached++;
+		return *values;
+	}
+
+	template<typename... Args, std::size_t K>
+	void StickySignal<void(Args...), K>::Replay(const Connection& connection) {
+		// the arguments are cached, so a burst of subscribers only copies them
+		for (std::size_t i = 0; i < numCached; i++) {
+			std::apply([this, &connection](const auto&... elems) {
+				Signal<void(Args...)>::InvokeSlot(connection, elems...);
+			}, Cached(i));
+		}
+	}
+}
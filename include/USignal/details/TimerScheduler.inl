@@ -0,0 +1,242 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <utility>
+
+namespace Ubpa {
+	template<typename Clock>
+	TimerScheduler<Clock>::TimerScheduler(Duration tick, Clock clock) :
+		tick{ tick }, clock{ std::move(clock) }
+	{
+		assert(tick > Duration::zero());
+		origin = this->clock.now();
+		heads.fill(Null);
+	}
+
+	template<typename Clock>
+	template<typename Task>
+	TimerHandle TimerScheduler<Clock>::After(Duration delay, Task&& task) {
+		static_assert(std::is_invocable_v<std::decay_t<Task>&>);
+		return Schedule(ToTicks(delay), 0,
+			[task = std::decay_t<Task>(std::forward<Task>(task))]() mutable {
+				task();
+				return false;
+			});
+	}
+
+	template<typename Clock>
+	template<typename Task>
+	TimerHandle TimerScheduler<Clock>::Every(Duration period, Task&& task) {
+		using R = std::invoke_result_t<std::decay_t<Task>&>;
+		static_assert(std::is_void_v<R> || std::is_same_v<R, bool>);
+		const std::uint64_t ticks = ToTicks(period);
+		if constexpr (std::is_same_v<R, bool>)
+			return Schedule(ticks, ticks, std::forward<Task>(task));
+		else {
+			return Schedule(ticks, ticks,
+				[task = std::decay_t<Task>(std::forward<Task>(task))]() mutable {
+					task();
+					return true;
+				});
+		}
+	}
+
+	template<typename Clock>
+	bool TimerScheduler<Clock>::Cancel(TimerHandle handle) noexcept {
+		if (!IsScheduled(handle))
+			return false;
+		Entry& entry = Get(handle.index);
+		if (entry.state == State::Firing) {
+			// the task is running, Step frees the entry after it returns
+			entry.state = State::Cancelled;
+			return true;
+		}
+		Unlink(handle.index);
+		Free(handle.index);
+		return true;
+	}
+
+	template<typename Clock>
+	bool TimerScheduler<Clock>::IsScheduled(TimerHandle handle) const noexcept {
+		if (!handle || handle.index >= numEntries)
+			return false;
+		const Entry& entry = Get(handle.index);
+		return entry.generation == handle.generation
+			&& (entry.state == State::Pending || entry.state == State::Firing);
+	}
+
+	template<typename Clock>
+	std::size_t TimerScheduler<Clock>::Update() { return AdvanceTo(clock.now()); }
+
+	template<typename Clock>
+	std::size_t TimerScheduler<Clock>::AdvanceTo(TimePoint time) {
+		if (time <= origin)
+			return 0;
+		const std::uint64_t target = static_cast<std::uint64_t>((time - origin) / tick);
+		std::size_t n = 0;
+		while (now < target) {
+			// the ticks before the next due slot have nothing to cascade or call
+			const std::uint64_t next = numScheduled == 0 ? target + 1 : NextDue();
+			if (next > target) {
+				now = target;
+				break;
+			}
+			now = next - 1;
+			n += Step();
+		}
+		return n;
+	}
+
+	template<typename Clock>
+	std::uint64_t TimerScheduler<Clock>::NextDue() const noexcept {
+		std::uint64_t next = static_cast<std::uint64_t>(-1);
+		for (std::size_t level = 0; level < NumLevels; level++) {
+			const std::uint64_t mask = occupied[level];
+			if (mask == 0)
+				continue;
+			const std::size_t shift = level * SlotBits;
+			const std::size_t digit = static_cast<std::size_t>((now >> shift) & (NumSlots - 1));
+			const std::uint64_t rotation = (now >> (shift + SlotBits)) << (shift + SlotBits);
+			// the slots after the digit of now come due in this rotation, the others in the next one
+			const std::uint64_t after = digit + 1 < NumSlots ? mask & (~std::uint64_t{ 0 } << (digit + 1)) : 0;
+			const std::uint64_t due = after != 0
+				? rotation + (static_cast<std::uint64_t>(std::countr_zero(after)) << shift)
+				: rotation + (std::uint64_t{ 1 } << (shift + SlotBits)) + (static_cast<std::uint64_t>(std::countr_zero(mask)) << shift);
+			if (due < next)
+				next = due;
+		}
+		return next;
+	}
+
+	template<typename Clock>
+	std::uint64_t TimerScheduler<Clock>::ToTicks(Duration duration) const noexcept {
+		// round up, at least one tick
+		if (duration <= tick)
+			return 1;
+		return static_cast<std::uint64_t>((duration + tick - Duration{ 1 }) / tick);
+	}
+
+	template<typename Clock>
+	TimerHandle TimerScheduler<Clock>::Schedule(std::uint64_t delay, std::uint64_t period, unique_function<bool()> task) {
+		const std::uint32_t index = Allocate();
+		Entry& entry = Get(index);
+		entry.task = std::move(task);
+		entry.expiry = now + delay;
+		entry.period = period;
+		entry.state = State::Pending;
+		Place(index);
+		return { index, entry.generation };
+	}
+
+	template<typename Clock>
+	std::uint32_t TimerScheduler<Clock>::Allocate() {
+		numScheduled++;
+		if (freeList != Null) {
+			const std::uint32_t index = freeList;
+			freeList = Get(index).next;
+			return index;
+		}
+		assert(numEntries < Null);
+		if (numEntries % SlabSize == 0)
+			slabs.push_back(std::make_unique<Entry[]>(SlabSize));
+		return numEntries++;
+	}
+
+	template<typename Clock>
+	void TimerScheduler<Clock>::Free(std::uint32_t index) noexcept {
+		Entry& entry = Get(index);
+		// the task is destroyed after the handle is invalidated, so its destructor can't cancel it again
+		auto task = std::move(entry.task);
+		entry.state = State::Free;
+		if (++entry.generation == 0)
+			entry.generation = 1;
+		entry.next = freeList;
+		freeList = index;
+		numScheduled--;
+	}
+
+	template<typename Clock>
+	void TimerScheduler<Clock>::Place(std::uint32_t index) noexcept {
+		Entry& entry = Get(index);
+		assert(entry.expiry >= now);
+		const std::uint64_t delta = entry.expiry - now;
+		std::size_t level = static_cast<std::size_t>(std::bit_width(delta | 1) - 1) / SlotBits;
+		std::uint64_t expiry = entry.expiry;
+		if (level >= NumLevels) {
+			// beyond the wheel, it is placed again when the last slot of the top level is cascaded
+			level = NumLevels - 1;
+			expiry = now + MaxDelta;
+		}
+		// the slot comes due (is called or cascaded) at the first multiple of NumSlots^level which is not before now,
+		// in [now, expiry] and with the same digit as expiry
+		const std::size_t slot = level * NumSlots + ((expiry >> (level * SlotBits)) & (NumSlots - 1));
+		entry.slot = static_cast<std::uint16_t>(slot);
+		entry.prev = Null;
+		entry.next = heads[slot];
+		if (entry.next != Null)
+			Get(entry.next).prev = index;
+		heads[slot] = index;
+		occupied[level] |= std::uint64_t{ 1 } << (slot & (NumSlots - 1));
+	}
+
+	template<typename Clock>
+	void TimerScheduler<Clock>::Unlink(std::uint32_t index) noexcept {
+		Entry& entry = Get(index);
+		if (entry.prev != Null)
+			Get(entry.prev).next = entry.next;
+		else {
+			heads[entry.slot] = entry.next;
+			if (entry.next == Null)
+				occupied[entry.slot / NumSlots] &= ~(std::uint64_t{ 1 } << (entry.slot & (NumSlots - 1)));
+		}
+		if (entry.next != Null)
+			Get(entry.next).prev = entry.prev;
+	}
+
+	template<typename Clock>
+	void TimerScheduler<Clock>::Cascade(std::size_t level) noexcept {
+		const std::size_t slot = level * NumSlots + ((now >> (level * SlotBits)) & (NumSlots - 1));
+		std::uint32_t index = heads[slot];
+		heads[slot] = Null;
+		occupied[level] &= ~(std::uint64_t{ 1 } << (slot & (NumSlots - 1)));
+		while (index != Null) {
+			const std::uint32_t next = Get(index).next;
+			// a lower level, or this level again if the expiry is beyond the wheel
+			Place(index);
+			index = next;
+		}
+	}
+
+	template<typename Clock>
+	std::size_t TimerScheduler<Clock>::Step() {
+		now++;
+		for (std::size_t level = 1; level < NumLevels; level++) {
+			if ((now & ((std::uint64_t{ 1 } << (level * SlotBits)) - 1)) != 0)
+				break;
+			Cascade(level);
+		}
+
+		// the tasks of this tick can't schedule into this slot (the delay is at least one tick),
+		// but they can cancel the other entries of the slot, so it is popped one by one
+		std::size_t n = 0;
+		const std::size_t slot = now & (NumSlots - 1);
+		while (heads[slot] != Null) {
+			const std::uint32_t index = heads[slot];
+			Unlink(index);
+			Entry& entry = Get(index); // the slabs are stable, the tasks may schedule new entries
+			assert(entry.expiry == now);
+			entry.state = State::Firing;
+			const bool repeat = entry.task();
+			n++;
+			if (entry.state == State::Firing && entry.period != 0 && repeat) {
+				entry.state = State::Pending;
+				entry.expiry = now + entry.period;
+				Place(index);
+			}
+			else
+				Free(index);
+		}
+		return n;
+	}
+}
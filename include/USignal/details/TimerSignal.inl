@@ -0,0 +1,25 @@
+#pragma once
+
+namespace Ubpa {
+	template<typename... Args, typename Clock>
+	TimerHandle TimerSignal<void(Args...), Clock>::EmitAfter(Duration delay, std::type_identity_t<Args>... args)
+	{ return scheduler->After(delay, MakeTask(std::forward<Args>(args)...)); }
+
+	template<typename... Args, typename Clock>
+	TimerHandle TimerSignal<void(Args...), Clock>::EmitEvery(Duration period, std::type_identity_t<Args>... args)
+	{ return scheduler->Every(period, MakeTask(std::forward<Args>(args)...)); }
+
+	template<typename... Args, typename Clock>
+	auto TimerSignal<void(Args...), Clock>::MakeTask(std::type_identity_t<Args>... args) {
+		return [anchor = details::SignalAnchorRef{ this->GetAnchor() },
+			values = std::tuple<std::remove_cvref_t<Args>...>{ std::forward<Args>(args)... }]() {
+			auto* signal = static_cast<Signal<void(Args...)>*>(anchor.Get());
+			if (!signal)
+				return false;
+			std::apply([signal](const auto&... elems) {
+				signal->Emit(elems...);
+			}, values);
+			return true;
+		};
+	}
+}
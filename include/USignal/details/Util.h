@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <type_traits>
 #include <algorithm>
+#include <tuple>
+#include <utility>
 
 namespace Ubpa::details {
 	struct a { virtual ~a() = default; void f(); virtual void g(); };
@@ -26,16 +28,13 @@ namespace Ubpa::details {
 	union FuncPtr {
 		constexpr FuncPtr() noexcept : data{} {}
 
+		// the unused tail of data is zero, so that equal pointers compare equal
 		template<typename T>
-		constexpr FuncPtr(T t) noexcept {
+		constexpr FuncPtr(T t) noexcept : data{} {
 			static_assert(std::is_function_v<std::remove_pointer_t<T>>
 				|| std::is_member_function_pointer_v<T>
 				|| std::is_function_v<T>);
 			new(data)FuncPtrStorage<T>{ t };
-			if constexpr (sizeof(FuncPtrStorage<T>) < sizeof(FuncTypes) / sizeof(std::size_t)) {
-				for (std::size_t i = sizeof(FuncPtrStorage<T>); i < sizeof(FuncTypes) / sizeof(std::size_t); i++)
-					data[i] = 0;
-			}
 		}
 
 		constexpr void Reset() noexcept {
@@ -72,4 +71,19 @@ namespace Ubpa::details {
 	struct ObjectTypeOfGeneralMemFunc<T&> : ObjectTypeOfGeneralMemFunc<T> {};
 	template<typename T>
 	struct ObjectTypeOfGeneralMemFunc<T&&> : ObjectTypeOfGeneralMemFunc<T> {};
+
+	// pass a stored value to a slot parameter of type T, it is only moved if T is an rvalue reference
+	// so the value can be passed to several slots
+	template<typename T, typename U>
+	decltype(auto) PassSlotArg(U& value) noexcept {
+		if constexpr (std::is_rvalue_reference_v<T>)
+			return std::move(value);
+		else
+			return (value);
+	}
+
+	template<typename T>
+	struct IsTuple : std::false_type {};
+	template<typename... Ts>
+	struct IsTuple<std::tuple<Ts...>> : std::true_type {};
 }
@@ -0,0 +1,51 @@
+#include <USignal/USignal.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+
+// relocate a component array whose elements have two connections each
+// - Signal::MoveInstance per element
+// - Signal::RelocateRange once
+// a second array between dst and src stays connected, so the relocated block moves past its connections
+
+struct Component {
+	int value{ 0 };
+	void OnTick(int dt) { value += dt; }
+	void OnLateTick(int dt) { value -= dt; }
+};
+
+template<typename Relocate>
+double Run(std::size_t n, Relocate&& relocate) {
+	std::vector<Component> dst(n), others(n), src(n);
+	Signal<void(int)> sig;
+	for (auto* array : { &others, &src }) {
+		for (auto& c : *array) {
+			sig.Connect<&Component::OnTick>(&c);
+			sig.Connect<&Component::OnLateTick>(&c);
+		}
+	}
+	const auto begin = std::chrono::steady_clock::now();
+	relocate(sig, src, dst);
+	const auto end = std::chrono::steady_clock::now();
+	sig.Emit(1);
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+	for (std::size_t n : { 8, 1024, 8192 }) {
+		const double perElement = Run(n, [](Signal<void(int)>& sig, std::vector<Component>& src, std::vector<Component>& dst) {
+			for (std::size_t i = 0; i < src.size(); i++)
+				sig.MoveInstance(&dst[i], &src[i]);
+		});
+		const double range = Run(n, [](Signal<void(int)>& sig, std::vector<Component>& src, std::vector<Component>& dst) {
+			sig.RelocateRange(src.data(), src.data() + src.size(), dst.data());
+		});
+		std::cout << "elements: " << n << std::endl;
+		std::cout << "  MoveInstance : " << perElement * 1e3 << " ms" << std::endl;
+		std::cout << "  RelocateRange: " << range * 1e3 << " ms" << std::endl;
+	}
+	return 0;
+}
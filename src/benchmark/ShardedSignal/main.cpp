@@ -0,0 +1,83 @@
+#include <USignal/USignal.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Ubpa;
+
+// connect/disconnect throughput of short-lived listeners from many threads
+// - Signal guarded by a single mutex
+// - ShardedSignal
+
+struct Listener {
+	int cnt = 0;
+	void OnEvent(int) { cnt++; }
+};
+
+constexpr std::size_t NumListenersPerThread = 64;
+constexpr std::size_t NumRoundsPerThread = 20000;
+
+class LockedSignal {
+public:
+	void Connect(Listener* l) {
+		std::lock_guard<std::mutex> lock(mutex);
+		signal.Connect<&Listener::OnEvent>(l);
+	}
+	void Disconnect(Listener* l) {
+		std::lock_guard<std::mutex> lock(mutex);
+		signal.Disconnect(l);
+	}
+private:
+	std::mutex mutex;
+	Signal<void(int)> signal;
+};
+
+class ShardedListenerSignal {
+public:
+	void Connect(Listener* l) { signal.Connect<&Listener::OnEvent>(l); }
+	void Disconnect(Listener* l) { signal.Disconnect(l); }
+private:
+	ShardedSignal<void(int), 64> signal;
+};
+
+template<typename Sig>
+double Run(std::size_t numThreads) {
+	Sig sig;
+	auto work = [&sig]() {
+		std::vector<std::unique_ptr<Listener>> listeners(NumListenersPerThread);
+		for (auto& l : listeners)
+			l = std::make_unique<Listener>();
+		for (std::size_t r = 0; r < NumRoundsPerThread; r++) {
+			Listener* l = listeners[r % NumListenersPerThread].get();
+			sig.Connect(l);
+			sig.Disconnect(l);
+		}
+	};
+
+	const auto begin = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < numThreads; i++)
+		threads.emplace_back(work);
+	for (auto& t : threads)
+		t.join();
+	const auto end = std::chrono::steady_clock::now();
+
+	const double seconds = std::chrono::duration<double>(end - begin).count();
+	return static_cast<double>(2 * numThreads * NumRoundsPerThread) / seconds;
+}
+
+int main() {
+	const std::size_t maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	std::cout << "threads, locked Signal (Mops/s), ShardedSignal (Mops/s)" << std::endl;
+	for (std::size_t n = 1; n <= maxThreads; n *= 2) {
+		const double locked = Run<LockedSignal>(n);
+		const double sharded = Run<ShardedListenerSignal>(n);
+		std::cout << n << ", " << locked / 1e6 << ", " << sharded / 1e6 << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include <USignal/SharedMemorySignal.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Ubpa;
+
+// SharedMemorySignal between two processes
+// - throughput: the publisher emits as fast as it can, the subscriber's reader thread counts
+// - latency: ping-pong, the child answers every ping, half the round trip is reported
+
+constexpr std::size_t NumThroughputEmissions = 10'000'000;
+constexpr std::size_t NumPingPongs = 100'000;
+
+std::uint64_t Now() {
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// block until the other process writes a byte
+void Wait(int fd) {
+	char c;
+	if (::read(fd, &c, 1) != 1)
+		std::exit(1);
+}
+
+void Notify(int fd) {
+	const char c = 0;
+	if (::write(fd, &c, 1) != 1)
+		std::exit(1);
+}
+
+void Throughput(const std::string& name) {
+	SharedMemorySignal<void(std::uint64_t, std::uint64_t)> publisher(name.c_str(), SharedMemoryRole::Publisher, 1 << 16);
+	int ready[2], done[2], result[2];
+	if (!publisher.IsOpen() || ::pipe(ready) != 0 || ::pipe(done) != 0 || ::pipe(result) != 0)
+		std::exit(1);
+
+	const pid_t child = ::fork();
+	if (child == 0) {
+		SharedMemorySignal<void(std::uint64_t, std::uint64_t)> subscriber(name.c_str(), SharedMemoryRole::Subscriber);
+		std::atomic<std::uint64_t> received{ 0 };
+		std::atomic<bool> finished{ false };
+		subscriber.Connect([&](std::uint64_t i, std::uint64_t) {
+			if (i == ~std::uint64_t{ 0 })
+				finished = true;
+			else
+				received.fetch_add(1, std::memory_order_relaxed);
+		});
+		subscriber.Start();
+		Notify(ready[1]);
+		while (!finished)
+			std::this_thread::yield();
+		subscriber.Stop();
+		const std::uint64_t counts[2] = { received.load(), subscriber.NumDropped() };
+		if (::write(result[1], counts, sizeof(counts)) != sizeof(counts))
+			::_exit(1);
+		::_exit(0);
+	}
+
+	Wait(ready[0]);
+	const std::uint64_t begin = Now();
+	for (std::uint64_t i = 0; i < NumThroughputEmissions; i++)
+		publisher.Emit(i, i);
+	const std::uint64_t emitted = Now();
+	publisher.Emit(~std::uint64_t{ 0 }, 0);
+	std::uint64_t counts[2];
+	if (::read(result[0], counts, sizeof(counts)) != sizeof(counts))
+		std::exit(1);
+	const std::uint64_t end = Now();
+	::waitpid(child, nullptr, 0);
+
+	std::cout << "throughput" << std::endl
+		<< "  emit: " << NumThroughputEmissions * 1e3 / static_cast<double>(emitted - begin) << " M/s" << std::endl
+		<< "  receive: " << counts[0] * 1e3 / static_cast<double>(end - begin) << " M/s" << std::endl
+		<< "  dropped: " << counts[1] << " / " << NumThroughputEmissions << std::endl;
+}
+
+void Latency(const std::string& name, bool busyPoll) {
+	const std::string pingName = name + "_ping";
+	const std::string pongName = name + "_pong";
+	int ready[2];
+	if (::pipe(ready) != 0)
+		std::exit(1);
+
+	SharedMemorySignal<void(std::uint64_t)> ping(pingName.c_str(), SharedMemoryRole::Publisher);
+	const pid_t child = ::fork();
+	if (child == 0) {
+		SharedMemorySignal<void(std::uint64_t)> pong(pongName.c_str(), SharedMemoryRole::Publisher);
+		SharedMemorySignal<void(std::uint64_t)> pingIn(pingName.c_str(), SharedMemoryRole::Subscriber);
+		std::atomic<bool> finished{ false };
+		pingIn.Connect([&](std::uint64_t i) {
+			if (i == ~std::uint64_t{ 0 })
+				finished = true;
+			else
+				pong.Emit(i);
+		});
+		pingIn.Start();
+		Notify(ready[1]);
+		while (!finished)
+			std::this_thread::yield();
+		pingIn.Stop();
+		Wait(ready[0]); // the parent closed its subscriber
+		::_exit(0);
+	}
+
+	Wait(ready[0]);
+	SharedMemorySignal<void(std::uint64_t)> pongIn(pongName.c_str(), SharedMemoryRole::Subscriber);
+	if (!pongIn.IsOpen())
+		std::exit(1);
+	std::atomic<std::uint64_t> answered{ ~std::uint64_t{ 0 } };
+	pongIn.Connect([&](std::uint64_t i) { answered.store(i, std::memory_order_release); });
+	if (!busyPoll)
+		pongIn.Start();
+
+	std::vector<std::uint64_t> samples;
+	samples.reserve(NumPingPongs);
+	for (std::uint64_t i = 0; i < NumPingPongs; i++) {
+		const std::uint64_t begin = Now();
+		ping.Emit(i);
+		while (answered.load(std::memory_order_acquire) != i) {
+			if (busyPoll)
+				pongIn.Poll();
+			else
+				std::this_thread::yield();
+		}
+		samples.push_back((Now() - begin) / 2);
+	}
+	ping.Emit(~std::uint64_t{ 0 });
+	pongIn.Stop();
+	Notify(ready[1]);
+	::waitpid(child, nullptr, 0);
+
+	std::sort(samples.begin(), samples.end());
+	std::cout << "latency (" << (busyPoll ? "busy poll" : "reader thread") << ", one way)" << std::endl
+		<< "  p50: " << samples[samples.size() / 2] << " ns" << std::endl
+		<< "  p99: " << samples[samples.size() * 99 / 100] << " ns" << std::endl
+		<< "  max: " << samples.back() << " ns" << std::endl;
+}
+
+int main() {
+	const std::string name = "/USignal_benchmark_" + std::to_string(::getpid());
+	Throughput(name);
+	Latency(name, true);
+	Latency(name, false);
+	return 0;
+}
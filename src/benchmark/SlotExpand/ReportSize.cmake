@@ -0,0 +1,2 @@
+file(SIZE "${FILE}" size)
+message(STATUS "${FILE}: ${size} bytes")
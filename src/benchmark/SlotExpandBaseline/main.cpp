@@ -0,0 +1,53 @@
+#include <USignal/USignal.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace Ubpa;
+
+// the slots of src/benchmark/SlotExpand, wrapped in one lambda per function
+// every lambda is a new slot type with its own invoker, as SlotExpand::get/mem_get used to produce,
+// so the compile time and the object size grow with NumSlots
+
+#define USIGNAL_BENCH_REPEAT_8(M, p) M(p##0) M(p##1) M(p##2) M(p##3) M(p##4) M(p##5) M(p##6) M(p##7)
+#define USIGNAL_BENCH_REPEAT_64(M) \
+	USIGNAL_BENCH_REPEAT_8(M, 0) USIGNAL_BENCH_REPEAT_8(M, 1) USIGNAL_BENCH_REPEAT_8(M, 2) USIGNAL_BENCH_REPEAT_8(M, 3) \
+	USIGNAL_BENCH_REPEAT_8(M, 4) USIGNAL_BENCH_REPEAT_8(M, 5) USIGNAL_BENCH_REPEAT_8(M, 6) USIGNAL_BENCH_REPEAT_8(M, 7)
+
+constexpr int NumSlots = 64;
+
+struct Receiver {
+#define USIGNAL_BENCH_MEMBER(i) void OnValue##i(int v) { sum += v + i; }
+	USIGNAL_BENCH_REPEAT_64(USIGNAL_BENCH_MEMBER)
+#undef USIGNAL_BENCH_MEMBER
+	long long sum = 0;
+};
+
+long long global_sum = 0;
+#define USIGNAL_BENCH_FREE(i) void OnValue##i(int v) { global_sum += v + i; }
+USIGNAL_BENCH_REPEAT_64(USIGNAL_BENCH_FREE)
+#undef USIGNAL_BENCH_FREE
+
+int main() {
+	Signal<void(int)> sig;
+	Receiver r;
+#define USIGNAL_BENCH_CONNECT(i) \
+	sig.Connect([&r](int v) { r.OnValue##i(v); }); \
+	sig.Connect([](int v) { OnValue##i(v); });
+	USIGNAL_BENCH_REPEAT_64(USIGNAL_BENCH_CONNECT)
+#undef USIGNAL_BENCH_CONNECT
+
+	sig.Emit(1);
+	std::cout << "slots: " << sig.Size() << " (expect " << 2 * NumSlots << ")" << std::endl;
+
+	// the emit time per slot call
+	constexpr int NumEmits = 100000;
+	const auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < NumEmits; i++)
+		sig.Emit(i);
+	const auto end = std::chrono::steady_clock::now();
+	std::cout << "emit: " << std::chrono::duration<double, std::nano>(end - begin).count() / (NumEmits * sig.Size())
+		<< " ns per slot call" << std::endl;
+	std::cout << "sum: " << r.sum + global_sum << std::endl;
+	return 0;
+}
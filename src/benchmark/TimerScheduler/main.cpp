@@ -0,0 +1,98 @@
+#include <USignal/USignal.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace Ubpa;
+
+// schedule delayed emissions, cancel half of them, then run the clock until all are due
+// - std::priority_queue of std::function (cancel by a flag)
+// - TimerScheduler (hierarchical timing wheel)
+// the clock is simulated, so only the scheduling work is measured
+
+constexpr std::size_t NumTimers = 1 << 20;
+constexpr std::chrono::milliseconds MaxDelay{ 60000 };
+constexpr std::chrono::milliseconds Frame{ 16 };
+
+struct SimClock {
+	using duration = std::chrono::milliseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<SimClock>;
+	static constexpr bool is_steady = true;
+
+	static inline time_point current{};
+	static time_point now() noexcept { return current; }
+};
+
+std::vector<std::chrono::milliseconds> MakeDelays() {
+	std::mt19937 rng{ 42 };
+	std::uniform_int_distribution<std::chrono::milliseconds::rep> dist{ 1, MaxDelay.count() };
+	std::vector<std::chrono::milliseconds> delays(NumTimers);
+	for (auto& d : delays)
+		d = std::chrono::milliseconds{ dist(rng) };
+	return delays;
+}
+
+double RunHeap(const std::vector<std::chrono::milliseconds>& delays, std::size_t& fired) {
+	struct Item {
+		std::chrono::milliseconds time;
+		std::size_t id;
+		std::function<void()> task;
+		bool operator<(const Item& rhs) const { return time > rhs.time; }
+	};
+	Signal<void(int)> timeout;
+	timeout.Connect([&fired](int) { fired++; });
+
+	const auto begin = std::chrono::steady_clock::now();
+	std::priority_queue<Item> queue;
+	std::vector<bool> canceled(delays.size());
+	for (std::size_t i = 0; i < delays.size(); i++)
+		queue.push({ delays[i], i, [&timeout, i]() { timeout.Emit(static_cast<int>(i)); } });
+	for (std::size_t i = 0; i < delays.size(); i += 2)
+		canceled[i] = true;
+	for (std::chrono::milliseconds now{ 0 }; !queue.empty(); now += Frame) {
+		while (!queue.empty() && queue.top().time <= now) {
+			if (!canceled[queue.top().id])
+				queue.top().task();
+			queue.pop();
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+double RunWheel(const std::vector<std::chrono::milliseconds>& delays, std::size_t& fired) {
+	SimClock::current = {};
+	TimerScheduler<SimClock> scheduler;
+	TimerSignal<void(int), SimClock> timeout(scheduler);
+	timeout.Connect([&fired](int) { fired++; });
+
+	const auto begin = std::chrono::steady_clock::now();
+	std::vector<TimerHandle> handles(delays.size());
+	for (std::size_t i = 0; i < delays.size(); i++)
+		handles[i] = timeout.EmitAfter(delays[i], static_cast<int>(i));
+	for (std::size_t i = 0; i < delays.size(); i += 2)
+		timeout.Cancel(handles[i]);
+	while (scheduler.Size() > 0) {
+		SimClock::current += Frame;
+		scheduler.Update();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+	const auto delays = MakeDelays();
+	std::size_t heapFired = 0, wheelFired = 0;
+	const double heap = RunHeap(delays, heapFired);
+	const double wheel = RunWheel(delays, wheelFired);
+	std::cout << "timers: " << NumTimers << ", fired: " << heapFired << " / " << wheelFired << std::endl;
+	std::cout << "priority_queue: " << heap * 1e3 << " ms" << std::endl;
+	std::cout << "TimerScheduler: " << wheel * 1e3 << " ms" << std::endl;
+	return 0;
+}
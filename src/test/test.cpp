@@ -2,6 +2,20 @@
 
 #include <USignal/USignal.hpp>
 
+#include <random>
+#include <thread>
+
+#ifdef __linux__
+#include <USignal/EmissionLog.hpp>
+#include <USignal/SharedMemorySignal.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace Ubpa;
 
 TEST(Signal, ctor) {
@@ -110,6 +124,24 @@ TEST(Signal, memfunc) {
 	EXPECT_TRUE(c.called_3);
 }
 
+namespace {
+	int funcptr_cnt = 0;
+	void funcptr_slot(int) { funcptr_cnt++; }
+	void funcptr_slot_other(int, float) { funcptr_cnt += 10; }
+}
+
+TEST(Signal, funcptr) {
+	Signal<void(int, float)> sig;
+	sig.Connect<&funcptr_slot>();
+	sig.Connect(&funcptr_slot_other);
+	sig.Emit(0, 0.f);
+	EXPECT_EQ(funcptr_cnt, 11);
+	sig.Disconnect<&funcptr_slot>();
+	sig.Disconnect<&funcptr_slot_other>();
+	sig.Emit(0, 0.f);
+	EXPECT_EQ(funcptr_cnt, 11);
+}
+
 TEST(Signal, callable_obj) {
 	Signal<void(int, float)> sig;
 	struct Func {
@@ -270,6 +302,69 @@ TEST(Signal, move) {
 	EXPECT_EQ(cnt, 0);
 }
 
+TEST(Signal, relocate_range) {
+	struct Base {
+		int cnt = 0;
+		void g() { cnt += 10; }
+	};
+	struct A : Base {
+		int data = 0;
+		void f() { data++; }
+	};
+	Signal<void()> sig;
+	std::vector<A> src(8);
+	A other;
+	std::vector<ScopedConnection<void()>> conns;
+	for (auto& a : src) {
+		sig.Connect<&A::f>(&a);
+		conns.push_back(sig.ScopeConnect<&Base::g>(&a));
+	}
+	sig.Connect<&A::f>(&other);
+
+	std::vector<A> dst(src.size());
+	sig.RelocateRange(src.data(), src.data() + src.size(), dst.data());
+	RelocateRange(std::span{ conns }, src.data(), src.data() + src.size(), dst.data());
+	sig.Emit();
+	for (std::size_t i = 0; i < src.size(); i++) {
+		EXPECT_EQ(src[i].data, 0);
+		EXPECT_EQ(dst[i].data, 1);
+		EXPECT_EQ(dst[i].cnt, 10);
+		EXPECT_EQ(conns[i].instance, static_cast<Base*>(&dst[i]));
+	}
+	EXPECT_EQ(other.data, 1);
+
+	conns.clear();
+	EXPECT_EQ(sig.Size(), src.size() + 1);
+	sig.Disconnect(&dst[3]);
+	EXPECT_EQ(sig.Size(), src.size());
+
+	// the relocated block moves across the connections of other arrays, in both directions
+	Signal<void()> many;
+	std::vector<A> a(1000), b(1000), c(1000);
+	for (auto* array : { &a, &b }) {
+		for (auto& elem : *array) {
+			many.Connect<&A::f>(&elem);
+			many.Connect<&Base::g>(&elem);
+		}
+	}
+	std::vector<A>* from = &a;
+	std::vector<A>* to = &c;
+	for (int i = 0; i < 2; i++) {
+		many.RelocateRange(from->data(), from->data() + from->size(), to->data());
+		std::swap(from, to);
+	}
+	many.Emit();
+	for (std::size_t i = 0; i < a.size(); i++) {
+		EXPECT_EQ(a[i].data, 1);
+		EXPECT_EQ(a[i].cnt, 10);
+		EXPECT_EQ(b[i].data, 1);
+		EXPECT_EQ(c[i].data, 0);
+	}
+	many.Disconnect(&b[0]);
+	many.Disconnect(&a[999]);
+	EXPECT_EQ(many.Size(), 4 * a.size() - 4);
+}
+
 TEST(Signal, acc) {
 	Signal<int()> getints;
 	getints.Connect([]() {return 1; });
@@ -286,6 +381,154 @@ TEST(Signal, acc) {
 	EXPECT_EQ(acc.sum, 6);
 }
 
+TEST(Signal, emit_collect) {
+	Signal<int(int)> sig;
+	sig.Connect([](int x) { return x + 1; });
+	sig.Connect([](int x) { return x + 2; });
+	sig.Connect([](int x) { return x + 3; });
+	EXPECT_EQ(sig.Size(), 3);
+
+	int buffer[3] = { 0,0,0 };
+	EXPECT_EQ(sig.EmitCollect(buffer, 10), 3);
+	EXPECT_EQ(buffer[0] + buffer[1] + buffer[2], 36);
+
+	int small_buffer[2] = { 0,0 };
+	EXPECT_EQ(sig.EmitCollect(small_buffer, 10), 2);
+
+	std::vector<int> results;
+	EXPECT_EQ(sig.EmitCollect(results, 0), 3);
+	EXPECT_EQ(results.size(), 3);
+	const int* data = results.data();
+	EXPECT_EQ(sig.EmitCollect(results, 1), 3);
+	EXPECT_EQ(results.data(), data);
+	EXPECT_EQ(results[0] + results[1] + results[2], 9);
+}
+
+TEST(Signal, emit_until) {
+	Signal<bool(int)> sig;
+	int cnt = 0;
+	sig.Connect([&](int x) { cnt++; return x == 0; });
+	Connection consumer = sig.Connect([&](int x) { cnt++; return x == 1; });
+	sig.Connect([&](int) { cnt++; return true; });
+
+	auto rst = sig.EmitUntil([](bool consumed) { return consumed; }, 1);
+	ASSERT_TRUE(rst.has_value());
+	EXPECT_TRUE(*rst == consumer);
+	EXPECT_EQ(cnt, 2);
+
+	cnt = 0;
+	rst = sig.EmitUntil([](bool) { return false; }, 1);
+	EXPECT_FALSE(rst.has_value());
+	EXPECT_EQ(cnt, 3);
+}
+
+TEST(Signal, stop_emit) {
+	Signal<void(int)> sig;
+	int cnt = 0;
+	sig.Connect([&](int) { cnt++; });
+	Connection consumer = sig.Connect([&](int x) {
+		cnt++;
+		if (x > 0)
+			sig.StopEmit();
+	});
+	sig.Connect([&](int) { cnt++; });
+
+	auto rst = sig.EmitUntil(1);
+	ASSERT_TRUE(rst.has_value());
+	EXPECT_TRUE(*rst == consumer);
+	EXPECT_EQ(cnt, 2);
+
+	cnt = 0;
+	rst = sig.EmitUntil(0);
+	EXPECT_FALSE(rst.has_value());
+	EXPECT_EQ(cnt, 3);
+}
+
+TEST(Signal, stop_emit_in_emit) {
+	Signal<void()> sig;
+	int cnt = 0;
+	bool stop = true;
+	sig.Connect([&]() { if (stop) sig.StopEmit(); });
+	sig.Connect([&]() { cnt++; });
+	// no effect on Emit, and it doesn't leak into the next EmitUntil
+	sig.Emit();
+	EXPECT_EQ(cnt, 1);
+	stop = false;
+	EXPECT_FALSE(sig.EmitUntil().has_value());
+	EXPECT_EQ(cnt, 2);
+}
+
+TEST(Signal, memory_usage) {
+	Signal<void(int)> sig;
+	const std::size_t empty_usage = sig.MemoryUsage();
+	EXPECT_GE(empty_usage, sizeof(Signal<void(int)>));
+
+	struct Big { char data[256]; };
+	Connection conn = sig.Connect([big = Big{}](int) { (void)big; });
+	const std::size_t usage = sig.MemoryUsage();
+	EXPECT_GE(usage, empty_usage + sizeof(Big));
+	sig.Disconnect(conn);
+	EXPECT_LT(sig.MemoryUsage(), usage - sizeof(Big) + sizeof(std::size_t));
+
+	for (int i = 0; i < 100; i++)
+		sig.Connect([](int) {});
+	EXPECT_GE(sig.MemoryUsage(), empty_usage + 100 * sizeof(Connection));
+}
+
+TEST(Signal, move_assign_heap_slots) {
+	struct Big { char data[256]; };
+	int cnt = 0;
+	Signal<void(int)> a, b;
+	a.Connect([big = Big{}, &cnt](int) { (void)big; cnt += 1; });
+	b.Connect([big = Big{}, &cnt](int) { (void)big; cnt += 10; });
+	const std::size_t usage = b.MemoryUsage();
+	// the old slots of a are destroyed before its anchor (their counter)
+	a = std::move(b);
+	EXPECT_EQ(a.MemoryUsage(), usage);
+	a.Emit(0);
+	EXPECT_EQ(cnt, 10);
+	a = Signal<void(int)>{};
+	EXPECT_TRUE(a.Empty());
+}
+
+TEST(Signal, registry) {
+	auto& registry = SignalRegistry::Instance();
+	const std::size_t num = registry.NumSignals();
+	Signal<void(int)> small_sig;
+	Signal<void()> large_sig;
+	for (int i = 0; i < 100; i++)
+		large_sig.Connect([] {});
+	{
+		SignalRegistration r0 = registry.Register(&small_sig, "small");
+		SignalRegistration r1 = registry.Register(&large_sig, "large");
+		EXPECT_EQ(registry.NumSignals(), num + 2);
+		auto stats = registry.Snapshot();
+		auto large = std::find_if(stats.begin(), stats.end(), [](const SignalStats& s) { return s.name == "large"; });
+		auto small = std::find_if(stats.begin(), stats.end(), [](const SignalStats& s) { return s.name == "small"; });
+		ASSERT_TRUE(large != stats.end());
+		ASSERT_TRUE(small != stats.end());
+		EXPECT_TRUE(large < small);
+		EXPECT_EQ(large->numSlots, 100);
+		EXPECT_EQ(large->memoryUsage, large_sig.MemoryUsage());
+	}
+	EXPECT_EQ(registry.NumSignals(), num);
+
+	struct Owner {
+		MSignal<Owner, void(int)> changed;
+		Owner() { changed.Connect([](int) {}); }
+	} owner;
+	{
+		SignalRegistration r = registry.Register(&owner.changed, "member");
+		auto stats = registry.Snapshot();
+		auto member = std::find_if(stats.begin(), stats.end(), [](const SignalStats& s) { return s.name == "member"; });
+		ASSERT_TRUE(member != stats.end());
+		EXPECT_EQ(member->signal, &owner.changed);
+		EXPECT_EQ(member->numSlots, 1);
+		EXPECT_EQ(member->memoryUsage, owner.changed.MemoryUsage());
+	}
+	EXPECT_EQ(registry.NumSignals(), num);
+}
+
 TEST(Signal, scope) {
 	Signal<void()> sig;
 	int cnt = 0;
@@ -350,6 +593,1042 @@ TEST(Signal, scope_move) {
 }
 
 
+TEST(Signal, emit_lazy) {
+	Signal<void(const std::string&, int)> sig;
+	int built = 0;
+	auto factory = [&]() {
+		built++;
+		return std::tuple{ std::string("snapshot"), 3 };
+	};
+	EXPECT_TRUE(sig.Empty());
+	EXPECT_FALSE(sig.EmitLazy(factory));
+	EXPECT_EQ(built, 0);
+
+	struct A {
+		std::size_t sum{ 0 };
+		void f(const std::string& s, int n) { sum += s.size() * n; }
+	};
+	A a0, a1;
+	sig.Connect<&A::f>(&a0);
+	sig.Connect<&A::f>(&a1);
+	EXPECT_FALSE(sig.Empty());
+	EXPECT_TRUE(sig.EmitLazy(factory));
+	EXPECT_EQ(built, 1);
+	EXPECT_EQ(a0.sum, 24);
+	EXPECT_EQ(a1.sum, 24);
+
+	// only a1 runs, nothing is built if no slot passes the filter
+	EXPECT_TRUE(sig.EmitLazy([&](const Connection& c) { return c.instance == &a1; }, factory));
+	EXPECT_EQ(built, 2);
+	EXPECT_EQ(a0.sum, 24);
+	EXPECT_EQ(a1.sum, 48);
+	EXPECT_FALSE(sig.EmitLazy([](const Connection& c) { return c.instance == nullptr; }, factory));
+	EXPECT_EQ(built, 2);
+
+	Signal<void(std::string)> single;
+	std::string received;
+	single.Connect([&](std::string s) { received = std::move(s); });
+	single.EmitLazy([]() { return std::string("abc"); });
+	EXPECT_EQ(received, "abc");
+}
+
+namespace {
+	struct Particle {
+		int ticks{ 0 };
+		static void OnTickBatch(std::span<Particle*> particles, int dt) {
+			for (Particle* p : particles)
+				p->ticks += dt;
+			calls++;
+		}
+		static inline int calls = 0;
+	};
+}
+
+TEST(Signal, batch) {
+	Signal<void(int)> sig;
+	std::vector<Particle> particles(100);
+	for (auto& p : particles)
+		sig.ConnectBatch<&Particle::OnTickBatch>(&p);
+	int cnt = 0;
+	Connection lambdaConn = sig.Connect([&](int) { cnt++; });
+	EXPECT_EQ(sig.Size(), 101);
+
+	sig.Emit(2);
+	EXPECT_EQ(Particle::calls, 1);
+	EXPECT_EQ(cnt, 1);
+	for (const auto& p : particles)
+		EXPECT_EQ(p.ticks, 2);
+
+	sig.Disconnect(Connection{ &particles[0], &Particle::OnTickBatch });
+	sig.Disconnect(&particles[1]);
+	{
+		auto scoped = sig.ScopeConnectBatch<&Particle::OnTickBatch>(&particles[1]);
+		EXPECT_EQ(sig.Size(), 100);
+	}
+	EXPECT_EQ(sig.Size(), 99);
+
+	std::vector<Particle> moved(particles.size());
+	sig.RelocateRange(particles.data(), particles.data() + particles.size(), moved.data());
+	sig.Emit(1);
+	EXPECT_EQ(Particle::calls, 2);
+	EXPECT_EQ(moved[0].ticks, 0);
+	EXPECT_EQ(moved[1].ticks, 0);
+	for (std::size_t i = 2; i < moved.size(); i++)
+		EXPECT_EQ(moved[i].ticks, 1);
+	sig.Disconnect(lambdaConn);
+	for (std::size_t i = 2; i < moved.size(); i++)
+		sig.Disconnect(&moved[i]);
+	// the empty batch is removed with its slot
+	EXPECT_TRUE(sig.Empty());
+
+	// disconnecting the batch function removes the whole batch
+	for (auto& p : moved)
+		sig.ConnectBatch<&Particle::OnTickBatch>(&p);
+	EXPECT_EQ(sig.Size(), moved.size());
+	sig.Disconnect<&Particle::OnTickBatch>();
+	EXPECT_TRUE(sig.Empty());
+	EXPECT_EQ(sig.Size(), 0);
+	sig.ConnectBatch<&Particle::OnTickBatch>(&moved[0]);
+	sig.Emit(1);
+	EXPECT_EQ(Particle::calls, 3);
+	EXPECT_EQ(moved[0].ticks, 1);
+	EXPECT_EQ(moved[1].ticks, 0);
+}
+
+TEST(Signal, sticky) {
+	StickySignal<void(const std::string&, int)> state;
+	std::vector<std::string> log;
+	auto slot = [&](const std::string& s, int n) { log.push_back(s + std::to_string(n)); };
+
+	// nothing is cached yet
+	state.ConnectReplay(slot);
+	EXPECT_TRUE(log.empty());
+	EXPECT_EQ(state.Latest(), nullptr);
+
+	state.Emit("a", 1);
+	EXPECT_EQ(log, std::vector<std::string>{ "a1" });
+	ASSERT_NE(state.Latest(), nullptr);
+	EXPECT_EQ(std::get<1>(*state.Latest()), 1);
+
+	// only the new slot is called with the cached value
+	log.clear();
+	{
+		auto scoped = state.ScopeConnectReplay(slot);
+		EXPECT_EQ(log, std::vector<std::string>{ "a1" });
+		state.Connect(slot);
+		EXPECT_EQ(log, std::vector<std::string>{ "a1" });
+		EXPECT_EQ(state.Size(), 3);
+	}
+	EXPECT_EQ(state.Size(), 2);
+
+	state.Set("b", 2);
+	log.clear();
+	state.ConnectReplay(slot);
+	EXPECT_EQ(log, std::vector<std::string>{ "b2" });
+
+	struct A {
+		std::vector<int> history;
+		void f(int x) { history.push_back(x); }
+	};
+	StickySignal<void(int), 3> ring;
+	for (int i = 0; i < 5; i++)
+		ring.Emit(i);
+	EXPECT_EQ(ring.NumCached(), 3);
+	EXPECT_EQ(std::get<0>(ring.Cached(0)), 2);
+	A a;
+	ring.ConnectReplay<&A::f>(&a);
+	EXPECT_EQ(a.history, (std::vector<int>{ 2, 3, 4 }));
+	ring.ResetCache();
+	EXPECT_EQ(ring.NumCached(), 0);
+	ring.Emit(5);
+	EXPECT_EQ(a.history.back(), 5);
+
+	// replay in lazy connect mode
+	StickySignal<void(int)> lazy;
+	lazy.SetLazyConnect(true);
+	lazy.Emit(7);
+	int sum = 0;
+	for (int i = 0; i < 100; i++)
+		lazy.ConnectReplay([&sum](int x) { sum += x; });
+	EXPECT_EQ(sum, 700);
+	lazy.Emit(1);
+	EXPECT_EQ(sum, 800);
+}
+
+TEST(Signal, tracked) {
+	struct Owner {
+		MSignal<Owner, void(int)> changed;
+		void Set(int x) { changed.Emit(x); }
+	};
+	struct Listener {
+		int value{ 0 };
+		void OnChanged(int x) { value = x; }
+	};
+
+	std::vector<Owner> owners(1);
+	std::vector<Listener> listeners(64);
+	std::vector<TrackedConnection<void(int)>> connections;
+	connections.push_back(owners[0].changed.ScopeConnectTracked<&Listener::OnChanged>(&listeners[0]));
+	// reallocate the owners, the signals are moved
+	for (std::size_t i = 1; i < listeners.size(); i++) {
+		owners.emplace_back();
+		connections.push_back(owners[i].changed.ScopeConnectTracked<&Listener::OnChanged>(&listeners[i]));
+	}
+	for (std::size_t i = 0; i < owners.size(); i++)
+		owners[i].Set(static_cast<int>(i) + 1);
+	for (std::size_t i = 0; i < listeners.size(); i++)
+		EXPECT_EQ(listeners[i].value, static_cast<int>(i) + 1);
+
+	EXPECT_EQ(connections[0].GetSignal()->Size(), 1);
+	connections[0].Release();
+	EXPECT_EQ(connections[0].GetSignal(), nullptr);
+	owners[0].Set(100);
+	EXPECT_EQ(listeners[0].value, 1);
+
+	// disconnecting from destroyed signals does nothing
+	owners.clear();
+	for (std::size_t i = 1; i < connections.size(); i++)
+		EXPECT_EQ(connections[i].GetSignal(), nullptr);
+	connections.clear();
+
+	Signal<void()> sig;
+	int cnt = 0;
+	auto conn = sig.ScopeConnectTracked([&]() { cnt++; });
+	Signal<void()> sig2;
+	sig2.Swap(sig);
+	EXPECT_EQ(conn.GetSignal(), &sig2);
+	sig = std::move(sig2);
+	EXPECT_EQ(conn.GetSignal(), &sig);
+	sig.Emit();
+	EXPECT_EQ(cnt, 1);
+	conn.Release();
+	EXPECT_TRUE(sig.Empty());
+}
+
+TEST(Signal, lazy_connect) {
+	struct A {
+		int cnt = 0;
+		void f() { cnt++; }
+		void g() { cnt += 10; }
+	};
+	Signal<void()> sig;
+	sig.SetLazyConnect(true);
+	A a0, a1, a2;
+	sig.Connect<&A::g>(&a2);
+	sig.Connect<&A::f>(&a0);
+	sig.Connect<&A::f>(&a2);
+	sig.Connect<&A::f>(&a1);
+	EXPECT_EQ(sig.Size(), 4);
+	sig.Emit();
+	EXPECT_EQ(a0.cnt, 1);
+	EXPECT_EQ(a1.cnt, 1);
+	EXPECT_EQ(a2.cnt, 11);
+
+	sig.Disconnect(&a2);
+	EXPECT_EQ(sig.Size(), 2);
+	sig.Connect<&A::g>(&a0);
+	sig.MoveInstance(&a2, &a0);
+	sig.Emit();
+	EXPECT_EQ(a0.cnt, 1);
+	EXPECT_EQ(a1.cnt, 2);
+	EXPECT_EQ(a2.cnt, 22);
+
+	// a duplicated connection is called once, as in eager mode
+	Signal<void()> dup;
+	dup.SetLazyConnect(true);
+	A a3;
+	dup.Connect<&A::f>(&a3);
+	dup.Connect<&A::f>(&a3);
+	EXPECT_EQ(dup.Size(), 1);
+	dup.Emit();
+	EXPECT_EQ(a3.cnt, 1);
+	// the merge keeps the sorted table and the appended slots
+	A a4;
+	dup.Connect<&A::g>(&a4);
+	dup.Connect<&A::f>(&a4);
+	dup.Disconnect<&A::g>(&a4);
+	dup.Connect<&A::f>(&a3);
+	dup.Connect<&A::f>(&a4);
+	EXPECT_EQ(dup.Size(), 2);
+	dup.Emit();
+	EXPECT_EQ(a3.cnt, 2);
+	EXPECT_EQ(a4.cnt, 1);
+
+	// the appended slots are merged between the sorted ones
+	std::vector<A> objs(200);
+	Signal<void()> mixed;
+	for (std::size_t i = 0; i < objs.size(); i += 2)
+		mixed.Connect<&A::f>(&objs[i]);
+	mixed.SetLazyConnect(true);
+	for (std::size_t i = objs.size() - 1; i < objs.size(); i -= 2)
+		mixed.Connect<&A::f>(&objs[i]);
+	mixed.Disconnect(&objs[0]);
+	EXPECT_EQ(mixed.Size(), objs.size() - 1);
+	for (std::size_t i = 1; i < objs.size(); i++)
+		mixed.Disconnect(&objs[i]);
+	EXPECT_TRUE(mixed.Empty());
+}
+
+TEST(Signal, operators) {
+	Signal<void(int)> a;
+	Signal<void(float)> b;
+	float sum = 0.f;
+	b.Connect([&sum](float v) { sum += v; });
+	a | Filter([](int v) { return v > 0; }) | Map([](int v) { return float(v) / 2.f; }) | Into(b);
+	EXPECT_EQ(a.Size(), 1);
+	a.Emit(-2);
+	a.Emit(3);
+	EXPECT_EQ(sum, 1.5f);
+
+	Signal<void(int, int)> c;
+	int rst = 0;
+	Connection conn = c
+		| Map([](int x, int y) { return x * y; })
+		| Filter([](int v) { return v % 2 == 0; })
+		| Map([](int v) { return v + 1; })
+		| Into([&rst](int v) { rst = v; });
+	c.Emit(3, 3);
+	EXPECT_EQ(rst, 0);
+	c.Emit(2, 3);
+	EXPECT_EQ(rst, 7);
+	c.Disconnect(conn);
+	EXPECT_EQ(c.Size(), 0);
+}
+
+TEST(Signal, shared_slot) {
+	int cnt = 0;
+	SharedSlot<void(int)> logger([&cnt](int) { cnt++; });
+	Signal<void(int)> sig0;
+	Signal<void(int, float)> sig1;
+	Signal<void(int, int)> sig2;
+	logger.ConnectTo(sig0);
+	logger.ConnectTo(sig1);
+	logger.ConnectTo(sig2);
+	EXPECT_EQ(logger.NumConnections(), 3);
+
+	sig0.Emit(0);
+	sig1.Emit(0, 0.f);
+	sig2.Emit(0, 0);
+	EXPECT_EQ(cnt, 3);
+
+	{
+		Signal<void(int)> sig3;
+		logger.ConnectTo(sig3);
+		EXPECT_EQ(logger.NumConnections(), 4);
+	}
+	EXPECT_EQ(logger.NumConnections(), 3);
+
+	logger.DisconnectAll();
+	EXPECT_EQ(logger.NumConnections(), 0);
+	EXPECT_EQ(sig0.Size(), 0);
+	EXPECT_EQ(sig1.Size(), 0);
+	EXPECT_EQ(sig2.Size(), 0);
+	sig0.Emit(0);
+	EXPECT_EQ(cnt, 3);
+
+	// the connected signals can be moved, the moved-from ones destroyed
+	std::vector<Signal<void(int)>> signals(2);
+	logger.ConnectTo(signals[0]);
+	logger.ConnectTo(signals[1]);
+	signals.reserve(64);
+	{
+		Signal<void(int)> moved = std::move(signals[0]);
+		logger.ConnectTo(moved);
+		signals[0] = std::move(moved);
+	}
+	EXPECT_EQ(logger.NumConnections(), 3);
+	logger.DisconnectAll();
+	EXPECT_EQ(logger.NumConnections(), 0);
+	EXPECT_TRUE(signals[0].Empty());
+	EXPECT_TRUE(signals[1].Empty());
+}
+
+TEST(Signal, fixed_capacity) {
+	struct A {
+		int sum = 0;
+		void f(int x) { sum += x; }
+		void g(int x) { sum += 2 * x; }
+	};
+	FixedCapacitySignal<void(int), 3> sig;
+	EXPECT_EQ(sig.Capacity(), 3);
+	A a0, a1;
+	int cnt = 0;
+	EXPECT_TRUE(sig.Connect<&A::f>(&a0).has_value());
+	EXPECT_TRUE(sig.Connect<&A::g>(&a0).has_value());
+	EXPECT_FALSE(sig.Connect<&A::g>(&a0).has_value());
+	auto conn = sig.Connect([&cnt](int) { cnt++; });
+	EXPECT_TRUE(conn.has_value());
+	EXPECT_TRUE(sig.Full());
+	EXPECT_FALSE(sig.Connect<&A::f>(&a1).has_value());
+
+	sig.Emit(1);
+	EXPECT_EQ(a0.sum, 3);
+	EXPECT_EQ(cnt, 1);
+
+	sig.MoveInstance(&a1, &a0);
+	sig.Emit(1);
+	EXPECT_EQ(a0.sum, 3);
+	EXPECT_EQ(a1.sum, 3);
+
+	sig.Disconnect(*conn);
+	EXPECT_EQ(sig.Size(), 2);
+	FixedCapacitySignal<void(int), 3> moved = std::move(sig);
+	EXPECT_EQ(moved.Size(), 2);
+	moved.Disconnect(&a1);
+	EXPECT_EQ(moved.Size(), 0);
+	moved.Emit(1);
+	EXPECT_EQ(a1.sum, 3);
+	EXPECT_EQ(cnt, 2);
+
+	// dst keeps its own connection with the same slot
+	A a2;
+	moved.Connect<&A::f>(&a0);
+	moved.Connect<&A::g>(&a0);
+	moved.Connect<&A::f>(&a2);
+	moved.MoveInstance(&a2, &a0);
+	EXPECT_EQ(moved.Size(), 2);
+	moved.Emit(1);
+	EXPECT_EQ(a0.sum, 3);
+	EXPECT_EQ(a2.sum, 3);
+	moved.Disconnect(&a2);
+	EXPECT_EQ(moved.Size(), 0);
+}
+
+TEST(Signal, sharded) {
+	struct A {
+		std::atomic<int> cnt{ 0 };
+		void f() { cnt++; }
+	};
+	ShardedSignal<void(), 4> sig;
+	std::atomic<int> cnt{ 0 };
+	Connection conn = sig.Connect([&cnt]() { cnt++; });
+
+	std::vector<std::unique_ptr<A>> objs(64);
+	for (auto& obj : objs)
+		obj = std::make_unique<A>();
+	auto work = [&](std::size_t offset) {
+		for (std::size_t i = offset; i < objs.size(); i += 4) {
+			sig.Connect<&A::f>(objs[i].get());
+			sig.Connect([](A& a) { a.cnt += 10; }, objs[i].get());
+		}
+	};
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < 4; i++)
+		threads.emplace_back(work, i);
+	for (auto& t : threads)
+		t.join();
+	EXPECT_EQ(sig.Size(), 1 + 2 * objs.size());
+
+	sig.Emit();
+	EXPECT_EQ(cnt, 1);
+	for (const auto& obj : objs)
+		EXPECT_EQ(obj->cnt, 11);
+
+	sig.Disconnect(conn);
+	for (std::size_t i = 0; i < objs.size(); i += 2)
+		sig.Disconnect(objs[i].get());
+	for (std::size_t i = 1; i < objs.size(); i += 2)
+		sig.Disconnect<&A::f>(objs[i].get());
+	EXPECT_EQ(sig.Size(), objs.size() / 2);
+	sig.Emit();
+	EXPECT_EQ(cnt, 1);
+	EXPECT_EQ(objs[0]->cnt, 11);
+	EXPECT_EQ(objs[1]->cnt, 21);
+}
+
+TEST(Signal, signal_group) {
+	struct A {
+		std::vector<int> log;
+		void OnPos(int x) { log.push_back(x); }
+		void OnName(const std::string& name) { log.push_back(static_cast<int>(name.size())); }
+		void OnAll(int x, const std::string& name) { log.push_back(100 * x + static_cast<int>(name.size())); }
+	};
+	SignalGroup<void(int), void(const std::string&)> group;
+	A a0, a1;
+	std::vector<int> freeLog;
+	group.Get<0>().Connect<&A::OnPos>(&a0);
+	group.Get<0>().Connect<&A::OnPos>(&a1);
+	group.Get<1>().Connect<&A::OnName>(&a1);
+	group.Get<1>().Connect<&A::OnName>(&a0);
+	group.Get<1>().Connect([&](const std::string& name) { freeLog.push_back(static_cast<int>(name.size())); });
+	group.Combined().Connect<&A::OnAll>(&a0);
+
+	A* first = std::less<A*>{}(&a0, &a1) ? &a0 : &a1;
+	std::vector<A*> order;
+	group.Get<0>().Connect([&](A& a, int) { order.push_back(&a); }, &a0);
+	group.Get<0>().Connect([&](A& a, int) { order.push_back(&a); }, &a1);
+	group.Get<1>().Connect([&](A& a, const std::string&) { order.push_back(&a); }, &a0);
+	group.Get<1>().Connect([&](A& a, const std::string&) { order.push_back(&a); }, &a1);
+
+	group.Emit(std::forward_as_tuple(3), std::forward_as_tuple("abcd"));
+	EXPECT_EQ(a0.log, (std::vector<int>{ 3, 4, 304 }));
+	EXPECT_EQ(a1.log, (std::vector<int>{ 3, 4 }));
+	EXPECT_EQ(freeLog, std::vector<int>{ 4 });
+	// all slots of one instance are called in a row
+	ASSERT_EQ(order.size(), 4);
+	EXPECT_EQ(order[0], first);
+	EXPECT_EQ(order[1], first);
+	EXPECT_NE(order[2], first);
+	EXPECT_NE(order[3], first);
+
+	// the signals can still be emitted alone, combined slots are not called
+	group.Get<0>().Emit(5);
+	EXPECT_EQ(a0.log.back(), 5);
+	EXPECT_EQ(a0.log.size(), 4);
+}
+
+TEST(Signal, clone) {
+	struct Listener {
+		int value{ 0 };
+		void Set(int x) { value = x; }
+		void Add(int x) { value += x; }
+	};
+	Listener l0, l1, l2;
+	Signal<void(int)> sig;
+	sig.Connect<&Listener::Set>(&l0);
+	sig.Connect<&Listener::Add>(&l0);
+	sig.Connect<&Listener::Set>(&l1);
+	sig.Connect<&funcptr_slot>();
+	int cnt = 0;
+	sig.Connect([&](int) { cnt++; }); // not copyable
+
+	// l0 -> l2, l1 is dropped
+	auto cloned = sig.Clone([&](void* instance) -> void* { return instance == &l0 ? &l2 : nullptr; });
+	EXPECT_EQ(cloned.Size(), 3);
+	funcptr_cnt = 0;
+	cloned.Emit(2);
+	EXPECT_EQ(l2.value, 4);
+	EXPECT_EQ(l0.value, 0);
+	EXPECT_EQ(l1.value, 0);
+	EXPECT_EQ(funcptr_cnt, 1);
+	EXPECT_EQ(cnt, 0);
+
+	// the identity map copies every copyable slot
+	EXPECT_EQ(sig.Clone([](void* instance) { return instance; }).Size(), 4);
+
+	Listener l3;
+	EXPECT_EQ(sig.CloneInstance(&l0, &l3), 2);
+	EXPECT_EQ(sig.CloneInstance(&l2, &l3), 0);
+	sig.Emit(3);
+	EXPECT_EQ(l0.value, 6);
+	EXPECT_EQ(l3.value, 6);
+	EXPECT_EQ(l1.value, 3);
+	EXPECT_EQ(cnt, 1);
+	sig.Disconnect(&l3);
+	EXPECT_EQ(sig.Size(), 5);
+
+	// l0 and l1 -> l2, the connections of l2 are merged
+	EXPECT_EQ(sig.Clone([&](void* instance) -> void* { return instance ? &l2 : nullptr; }).Size(), 3);
+	// the clones are merged into a table holding connections before and after dst
+	Listener l4;
+	sig.Connect<&Listener::Add>(&l3);
+	EXPECT_EQ(sig.CloneInstance(&l0, &l4), 2);
+	EXPECT_EQ(sig.CloneInstance(&l0, &l4), 0);
+	EXPECT_EQ(sig.Size(), 8);
+	sig.Emit(1);
+	EXPECT_EQ(l4.value, 2);
+	EXPECT_EQ(l3.value, 7);
+}
+
+namespace {
+	// a clock driven by the test
+	struct ManualClock {
+		using duration = std::chrono::milliseconds;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<ManualClock>;
+		static constexpr bool is_steady = true;
+
+		static inline time_point current{};
+		static time_point now() noexcept { return current; }
+	};
+}
+
+TEST(Signal, timer) {
+	using namespace std::chrono_literals;
+	TimerScheduler<ManualClock> scheduler;
+	auto advance = [&](ManualClock::duration d) {
+		ManualClock::current += d;
+		return scheduler.Update();
+	};
+
+	std::vector<int> log;
+	TimerSignal<void(int), ManualClock> timeout(scheduler);
+	timeout.Connect([&](int x) { log.push_back(x); });
+
+	timeout.EmitAfter(250ms, 1);
+	auto h2 = timeout.EmitAfter(100ms, 2);
+	timeout.EmitAfter(5000ms, 3); // level 2
+	timeout.EmitAfter(30h, 4); // beyond the wheel
+	EXPECT_EQ(scheduler.Size(), 4);
+	EXPECT_EQ(advance(99ms), 0);
+	EXPECT_EQ(advance(1ms), 1);
+	EXPECT_FALSE(scheduler.IsScheduled(h2));
+	EXPECT_FALSE(timeout.Cancel(h2));
+	EXPECT_EQ(advance(149ms), 0);
+	EXPECT_EQ(advance(1ms), 1);
+	EXPECT_EQ(advance(4749ms), 0);
+	EXPECT_EQ(advance(1ms), 1);
+	EXPECT_EQ(log, (std::vector<int>{ 2, 1, 3 }));
+	EXPECT_EQ(advance(30h - 5001ms), 0);
+	EXPECT_EQ(advance(1ms), 1);
+	EXPECT_EQ(log.back(), 4);
+
+	// periodic emissions, catching up in one update
+	auto every = timeout.EmitEvery(10ms, 5);
+	EXPECT_EQ(advance(35ms), 3);
+	EXPECT_TRUE(timeout.Cancel(every));
+	EXPECT_EQ(advance(100ms), 0);
+	EXPECT_EQ(scheduler.Size(), 0);
+
+	// cancel from a task
+	TimerHandle later;
+	scheduler.After(1ms, [&]() { EXPECT_TRUE(scheduler.Cancel(later)); });
+	later = timeout.EmitAfter(2ms, 6);
+	advance(10ms);
+	EXPECT_EQ(log.back(), 5);
+	int n = 0;
+	scheduler.Every(1ms, [&]() { return ++n < 3; });
+	advance(10ms);
+	EXPECT_EQ(n, 3);
+
+	// the emissions follow a moved signal and stop after it is destroyed
+	{
+		std::vector<TimerSignal<void(int), ManualClock>> signals;
+		signals.emplace_back(scheduler);
+		int sum = 0;
+		signals[0].Connect([&](int x) { sum += x; });
+		signals[0].EmitEvery(1ms, 1);
+		signals.emplace_back(scheduler);
+		signals.emplace_back(scheduler);
+		advance(2ms);
+		EXPECT_EQ(sum, 2);
+	}
+	EXPECT_EQ(scheduler.Size(), 1);
+	advance(1ms);
+	EXPECT_EQ(scheduler.Size(), 0);
+
+	// the ticks without due slots are skipped, every task is still called at its own tick
+	std::mt19937 rng{ 7 };
+	std::size_t numCalled = 0, numWrong = 0;
+	for (int i = 0; i < 2000; i++) {
+		const std::chrono::milliseconds delay{ std::uniform_int_distribution<long long>{ 1, 20'000'000 }(rng) };
+		scheduler.After(delay, [&, due = scheduler.Now() + delay]() {
+			numCalled++;
+			if (scheduler.Now() != due)
+				numWrong++;
+		});
+	}
+	while (scheduler.Size() > 0)
+		advance(std::chrono::milliseconds{ std::uniform_int_distribution<long long>{ 1, 200'000 }(rng) });
+	EXPECT_EQ(numCalled, 2000);
+	EXPECT_EQ(numWrong, 0);
+}
+
+TEST(Signal, property) {
+	Property<int> a{ 1 };
+	int numB = 0, numC = 0, numD = 0, numParity = 0;
+	Computed b([&](int x) { numB++; return x + 1; }, a);
+	Computed c([&](int x) { numC++; return x * 2; }, a);
+	Computed d([&](int x, int y) { numD++; return x + y; }, b, c);
+	Computed parity([&](int x) { numParity++; return x % 2; }, a);
+	Computed<std::string> label([](int p) { return p ? std::string{ "odd" } : std::string{ "even" }; }, parity);
+
+	// lazy
+	a.Set(2);
+	EXPECT_EQ(numB + numC + numD, 0);
+	EXPECT_EQ(d.Get(), 7);
+	EXPECT_EQ(numB, 1);
+	EXPECT_EQ(numC, 1);
+	EXPECT_EQ(numD, 1);
+	EXPECT_EQ(d.Get(), 7);
+	EXPECT_EQ(numD, 1);
+
+	// the observed diamond is recomputed once per change and never sees a mix of old and new values
+	std::vector<int> log;
+	d.changed.Connect([&](const int& x) {
+		EXPECT_EQ(x, b.Get() + c.Get());
+		log.push_back(x);
+	});
+	a.Set(3);
+	EXPECT_EQ(log, std::vector<int>{ 10 });
+	EXPECT_EQ(numD, 2);
+	a.Set(3); // equal
+	EXPECT_EQ(numD, 2);
+
+	// equal values stop the propagation
+	std::vector<std::string> labels;
+	label.changed.Connect([&](const std::string& s) { labels.push_back(s); }); // computed now
+	EXPECT_EQ(numParity, 1);
+	a.Set(4);
+	EXPECT_EQ(labels, std::vector<std::string>{ "even" });
+	a.Set(6);
+	EXPECT_EQ(numParity, 3);
+	EXPECT_EQ(labels.size(), 1);
+
+	// a batch recomputes the observed values once
+	Property<int> w{ 2 }, h{ 3 };
+	int numArea = 0;
+	Computed area([&](int x, int y) { numArea++; return x * y; }, w, h);
+	std::vector<int> areas;
+	area.changed.Connect([&](const int& x) { areas.push_back(x); });
+	{
+		PropertyBatch batch;
+		w.Set(4);
+		h.Set(5);
+		EXPECT_TRUE(areas.empty());
+	}
+	EXPECT_EQ(areas, std::vector<int>{ 20 });
+	EXPECT_EQ(numArea, 2); // connect, batch
+
+	// the changed signal of a property
+	int cnt = 0;
+	w.changed.Connect([&](const int&) { cnt++; });
+	w.Set(4);
+	w.Set(6);
+	EXPECT_EQ(cnt, 1);
+	EXPECT_EQ(areas.back(), 30);
+
+	// every connect path subscribes, a dirty node is updated at its first slot
+	Property<int> x{ 1 };
+	Computed y([](int v) { return v * 2; }, x);
+	Computed z([](int v) { return v + 1; }, y);
+	EXPECT_EQ(z.Get(), 3);
+	x.Set(2);
+	std::vector<int> zs;
+	auto tracked = z.changed.ScopeConnectTracked([&](const int& v) { zs.push_back(v); });
+	x.Set(3);
+	x.Set(4);
+	EXPECT_EQ(zs, (std::vector<int>{ 7, 9 }));
+}
+
+TEST(Signal, emit_incremental) {
+	using namespace std::chrono_literals;
+	Signal<void(const std::string&)> sig;
+	std::vector<std::string> log;
+	std::vector<Connection> connections;
+	for (int i = 0; i < 4; i++)
+		connections.push_back(sig.Connect([&log, i](const std::string& s) { log.push_back(s + std::to_string(i)); }));
+
+	// a zero budget calls one slot per resumption
+	auto cursor = sig.EmitIncremental(0ns, std::string{ "a" }); // the temporary is copied
+	EXPECT_FALSE(cursor.Done());
+	EXPECT_EQ(log, std::vector<std::string>{ "a0" });
+
+	// changes between resumptions
+	sig.Disconnect(connections[0]); // called
+	sig.Disconnect(connections[2]); // skipped
+	sig.Connect([&log](const std::string& s) { log.push_back(s + "4"); }); // after the last called slot
+	EXPECT_FALSE(cursor.Resume(0ns));
+	EXPECT_FALSE(cursor.Resume(0ns));
+	EXPECT_TRUE(cursor.Resume(0ns));
+	EXPECT_EQ(log, (std::vector<std::string>{ "a0", "a1", "a3", "a4" }));
+	EXPECT_EQ(cursor.NumCalled(), 4);
+	EXPECT_TRUE(cursor.Resume(1s));
+
+	// a large budget emits at once
+	log.clear();
+	EXPECT_TRUE(sig.EmitIncremental(1s, "b").Done());
+	EXPECT_EQ(log.size(), 3);
+
+	// StopEmit ends the emission
+	log.clear();
+	sig.Connect([&sig](const std::string&) { sig.StopEmit(); });
+	auto stopped = sig.EmitIncremental(1s, "c");
+	EXPECT_TRUE(stopped.Done());
+	EXPECT_EQ(log.size(), 3);
+
+	// the cursor follows a moved signal and ends with a destroyed one
+	auto moved = sig.EmitIncremental(0ns, "d");
+	auto sig2 = std::move(sig);
+	EXPECT_FALSE(moved.Resume(0ns));
+	EXPECT_EQ(log.back(), "d3");
+	{
+		auto sig3 = std::move(sig2);
+	}
+	EXPECT_TRUE(moved.Resume(0ns));
+	EXPECT_EQ(log.back(), "d3");
+}
+
+namespace {
+	struct Converted {
+		Converted(int v) : value{ v } { numConversions++; }
+		int value;
+		static inline int numConversions = 0;
+	};
+}
+
+TEST(Signal, multi_signal) {
+	struct Inventory {
+		std::vector<std::string> log;
+		void OnAdd(const std::string& item) { log.push_back("+" + item); }
+		void OnRemove(const std::string& item) { log.push_back("-" + item); }
+		void OnClear() { log.push_back("clear"); }
+	};
+	struct Counter {
+		int n = 0;
+		void OnAdd(const std::string&) { n++; }
+		void OnRemove(const std::string&) { n--; }
+	};
+
+	MultiSignal<void(const std::string&), void(const std::string&), void()> sig;
+	Inventory inv;
+	Counter c0, c1;
+	EXPECT_TRUE((sig.Connect<&Inventory::OnAdd, &Inventory::OnRemove, &Inventory::OnClear>(&inv)));
+	EXPECT_TRUE((sig.Connect<&Counter::OnAdd, &Counter::OnRemove, nullptr>(&c0)));
+	EXPECT_TRUE((sig.Connect<&Counter::OnAdd, nullptr, nullptr>(&c1)));
+	EXPECT_EQ(sig.Size(), 3);
+
+	sig.Emit<0>("apple");
+	sig.Emit<0>(std::string{ "pear" });
+	sig.Emit<1>("apple");
+	sig.Emit<2>();
+	EXPECT_EQ(inv.log, (std::vector<std::string>{ "+apple", "+pear", "-apple", "clear" }));
+	EXPECT_EQ(c0.n, 1);
+	EXPECT_EQ(c1.n, 2);
+
+	// reconnecting replaces the memslots
+	EXPECT_FALSE((sig.Connect<nullptr, &Counter::OnRemove, nullptr>(&c1)));
+	sig.Emit<0>("fig");
+	sig.Emit<1>("fig");
+	EXPECT_EQ(c1.n, 1);
+
+	// one erase disconnects all signatures
+	sig.Disconnect(&inv);
+	EXPECT_FALSE(sig.Contains(&inv));
+	sig.Emit<0>("kiwi");
+	sig.Emit<2>();
+	EXPECT_EQ(inv.log.size(), 6);
+
+	Counter c2;
+	sig.MoveInstance(&c2, &c0);
+	sig.Emit<0>("kiwi");
+	EXPECT_EQ(c0.n, 2);
+	EXPECT_EQ(c2.n, 1);
+	EXPECT_EQ(sig.Size(), 2);
+
+	// the arguments are converted once per emission
+	struct Receiver {
+		int sum = 0;
+		void On(const Converted& c) { sum += c.value; }
+	};
+	MultiSignal<void(const Converted&)> converting;
+	std::vector<Receiver> receivers(3);
+	for (auto& r : receivers)
+		converting.Connect<&Receiver::On>(&r);
+	converting.Emit<0>(2);
+	EXPECT_EQ(Converted::numConversions, 1);
+	for (const auto& r : receivers)
+		EXPECT_EQ(r.sum, 2);
+}
+
+TEST(Signal, multi_signal_multiple_inheritance) {
+	struct A { int a = 111; };
+	struct B {
+		int b = 0;
+		void OnAdd(int x) { b += x; }
+		void OnClear() { b = 0; }
+	};
+	struct C : A, B {};
+
+	MultiSignal<void(int), void()> sig;
+	C c;
+	EXPECT_TRUE((sig.Connect<&C::OnAdd, &C::OnClear>(&c)));
+	sig.Emit<0>(1);
+	EXPECT_EQ(c.a, 111);
+	EXPECT_EQ(c.b, 1);
+	// keyed by the B subobject
+	EXPECT_TRUE(sig.Contains(static_cast<B*>(&c)));
+	sig.Emit<1>();
+	EXPECT_EQ(c.b, 0);
+	sig.Disconnect(static_cast<B*>(&c));
+	EXPECT_TRUE(sig.Empty());
+}
+
+#ifdef __linux__
+TEST(Signal, emission_log) {
+	const std::string path = (std::filesystem::temp_directory_path() / "USignal_emission_log.bin").string();
+	Signal<void(int, float)> sig0;
+	Signal<void(const std::string&)> sig1;
+	{
+		EmissionRecorder recorder(path.c_str(), 1 << 20, 256);
+		ASSERT_TRUE(recorder.IsOpen());
+		auto work = [&](int base) {
+			for (int i = 0; i < 100; i++) {
+				recorder.Emit(0, sig0, base + i, 0.5f);
+				recorder.Emit(1, sig1, std::to_string(base + i));
+			}
+		};
+		std::thread t0(work, 0);
+		std::thread t1(work, 1000);
+		t0.join();
+		t1.join();
+		EXPECT_EQ(recorder.NumDropped(), 0);
+	}
+
+	int sum = 0;
+	int cnt0 = 0;
+	int cnt1 = 0;
+	sig0.Connect([&](int i, float f) {
+		sum += i;
+		cnt0++;
+		EXPECT_EQ(f, 0.5f);
+	});
+	sig1.Connect([&](const std::string& s) {
+		sum -= std::stoi(s);
+		cnt1++;
+	});
+
+	EmissionReplayer replayer(path.c_str());
+	ASSERT_TRUE(replayer.IsOpen());
+	EXPECT_EQ(replayer.NumRecords(), 400);
+	replayer.Bind(0, sig0);
+	EXPECT_EQ(replayer.Replay(0.), 200);
+	EXPECT_EQ(cnt0, 200);
+	replayer.Bind(1, sig1);
+	EXPECT_EQ(replayer.Replay(0.), 400);
+	EXPECT_EQ(cnt0, 400);
+	EXPECT_EQ(cnt1, 200);
+	// sig0 is replayed twice, sig1 once
+	EXPECT_EQ(sum, 99 * 100 / 2 + 100 * 1000 + 99 * 100 / 2);
+	std::filesystem::remove(path);
+}
+
+TEST(Signal, emission_log_malformed) {
+	const std::string path = (std::filesystem::temp_directory_path() / "USignal_emission_log_malformed.bin").string();
+	Signal<void(const std::string&)> sig;
+	{
+		EmissionRecorder recorder(path.c_str(), 1 << 20, 256);
+		ASSERT_TRUE(recorder.IsOpen());
+		for (int i = 0; i < 100; i++)
+			recorder.Emit(0, sig, std::to_string(i));
+	}
+	std::vector<char> bytes(std::filesystem::file_size(path));
+	{
+		std::ifstream file(path, std::ios::binary);
+		file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+	auto write = [&](const std::vector<char>& content) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	};
+	int cnt = 0;
+	sig.Connect([&](const std::string&) { cnt++; });
+
+	// truncated in the middle of a chunk
+	write(std::vector<char>(bytes.begin(), bytes.begin() + bytes.size() / 2));
+	{
+		EmissionReplayer replayer(path.c_str());
+		ASSERT_TRUE(replayer.IsOpen());
+		EXPECT_TRUE(replayer.IsMalformed());
+		EXPECT_GT(replayer.NumRecords(), 0);
+		EXPECT_LT(replayer.NumRecords(), 100);
+		replayer.Bind(0, sig);
+		EXPECT_EQ(replayer.Replay(0.), replayer.NumRecords());
+		EXPECT_EQ(cnt, replayer.NumRecords());
+	}
+
+	// header, chunk size, record header, string length
+	constexpr std::size_t firstChunk = 16;
+	constexpr std::size_t firstLength = firstChunk + 8 + 16;
+	const std::uint64_t huge = ~std::uint64_t{ 0 } - 4;
+
+	// a corrupted string length drops its record only
+	std::vector<char> corrupted = bytes;
+	std::memcpy(corrupted.data() + firstLength, &huge, sizeof(huge));
+	write(corrupted);
+	{
+		EmissionReplayer replayer(path.c_str());
+		ASSERT_TRUE(replayer.IsOpen());
+		EXPECT_FALSE(replayer.IsMalformed());
+		EXPECT_EQ(replayer.NumRecords(), 100);
+		replayer.Bind(0, sig);
+		EXPECT_EQ(replayer.Replay(0.), 99);
+		EXPECT_TRUE(replayer.IsMalformed());
+	}
+
+	// a corrupted chunk size stops the parsing
+	corrupted = bytes;
+	std::memcpy(corrupted.data() + firstChunk, &huge, sizeof(huge));
+	write(corrupted);
+	{
+		EmissionReplayer replayer(path.c_str());
+		ASSERT_TRUE(replayer.IsOpen());
+		EXPECT_TRUE(replayer.IsMalformed());
+		EXPECT_EQ(replayer.NumRecords(), 0);
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(Signal, shared_memory) {
+	const std::string name = "/USignal_test_" + std::to_string(::getpid());
+	constexpr int N = 1000;
+	// the ring buffer holds all the emissions, so the subscriber can't fall behind
+	auto publisher = std::make_unique<SharedMemorySignal<void(int, double)>>(name.c_str(), SharedMemoryRole::Publisher, N + 1);
+	ASSERT_TRUE(publisher->IsOpen());
+	// the shared memory object exists, it isn't truncated by another publisher
+	EXPECT_FALSE((SharedMemorySignal<void(int, double)>(name.c_str(), SharedMemoryRole::Publisher, 64).IsOpen()));
+
+	int ready[2];
+	ASSERT_EQ(::pipe(ready), 0);
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0) {
+		// subscriber process, it reports the result by the exit code
+		SharedMemorySignal<void(int, double)> subscriber(name.c_str(), SharedMemoryRole::Subscriber);
+		if (!subscriber.IsOpen())
+			::_exit(2);
+		std::atomic<long long> sum{ 0 };
+		std::atomic<bool> done{ false };
+		subscriber.Connect([&](int i, double d) {
+			if (i < 0)
+				done = true;
+			else
+				sum += i + static_cast<long long>(d);
+		});
+		subscriber.Start();
+		const char c = 0;
+		if (::write(ready[1], &c, 1) != 1)
+			::_exit(3);
+		while (!done)
+			std::this_thread::yield();
+		subscriber.Stop();
+		::_exit(sum == 2ll * N * (N - 1) / 2 && subscriber.NumDropped() == 0 ? 0 : 1);
+	}
+
+	char c;
+	ASSERT_EQ(::read(ready[0], &c, 1), 1);
+	for (int i = 0; i < N; i++)
+		publisher->Emit(i, static_cast<double>(i));
+	publisher->Emit(-1, 0.);
+	int status = 0;
+	ASSERT_EQ(::waitpid(child, &status, 0), child);
+	EXPECT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(WEXITSTATUS(status), 0);
+	::close(ready[0]);
+	::close(ready[1]);
+	publisher.reset();
+
+	// a subscriber that falls behind drops the oldest emissions
+	SharedMemorySignal<void(int, double)> small(name.c_str(), SharedMemoryRole::Publisher, 64);
+	ASSERT_TRUE(small.IsOpen());
+	SharedMemorySignal<void(int, double)> subscriber(name.c_str(), SharedMemoryRole::Subscriber);
+	ASSERT_TRUE(subscriber.IsOpen());
+	std::vector<int> received;
+	subscriber.Connect([&](int i, double) { received.push_back(i); });
+	for (int i = 0; i < 100; i++)
+		small.Emit(i, 0.);
+	EXPECT_EQ(subscriber.Poll(), 64);
+	EXPECT_EQ(subscriber.NumDropped(), 36);
+	EXPECT_EQ(received.front(), 36);
+	EXPECT_EQ(received.back(), 99);
+	EXPECT_EQ(subscriber.Poll(), 0);
+
+	SharedMemorySignal<void(int)> mismatch(name.c_str(), SharedMemoryRole::Subscriber);
+	EXPECT_FALSE(mismatch.IsOpen());
+}
+#endif
+
 template<typename T>
 concept MemberSignalTest0 = requires(T t) {
 	{ decltype(t.signal)(std::move(t.signal)) };